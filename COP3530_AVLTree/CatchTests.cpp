@@ -1,6 +1,9 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 #include "GatorAVL.h"
+#include "LockedGatorAVL.h"
+#include "ConcurrentGatorAVL.h"
+#include "GatorEpochReclaimer.h"
 
 TEST_CASE("Big Tree") {
 	GatorAVL avlTree;
@@ -36,15 +39,15 @@ TEST_CASE("Inorder Removals") {
 	avlTree.Insert("Dustin", "99999995");
 	avlTree.Insert("Gabriel", "99999994");
 	avlTree.Insert("Jerold", "99999993");
-	REQUIRE(avlTree.GetRoot()->name == "Lauren");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()) == "Lauren");
 
 	avlTree.RemoveInorder(3);	// Removing the median index removes the root node of the tree
-	REQUIRE(avlTree.GetRoot()->name != "Lauren");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()) != "Lauren");
 
 	avlTree.RemoveInorder(0);
 	avlTree.RemoveInorder(0);
 	avlTree.RemoveInorder(0);
-	REQUIRE(avlTree.GetRoot()->name == "Jack");	// The new root should be the median of the remaining three elements
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()) == "Jack");	// The new root should be the median of the remaining three elements
 
 	avlTree.RemoveInorder(9);	// Trying to remove from an out-of-bounds index
 	REQUIRE(avlTree.GetSize() == 3);	// Check that the size has not changed
@@ -133,3 +136,1197 @@ TEST_CASE("Height Correctness") {
 }
 
 
+
+
+TEST_CASE("Node Pool") {
+	GatorNodePool<int> pool(4);
+
+	int* first = pool.Allocate(1);
+	pool.Allocate(2);
+	pool.Free(first);
+	REQUIRE(pool.Allocate(3) == first);		// A freed slot should be reused before any new memory is requested
+	for (int i = 0; i < 3; i++) {
+		pool.Allocate(i);
+	}
+	REQUIRE(pool.GetChunkCount() == 2);		// Five live objects need a second chunk of four slots
+	REQUIRE(pool.GetInUseCount() == 5);
+
+	GatorNodePool<int> reserved(4);
+	reserved.Allocate(0);
+	reserved.Reserve(10);	// The three slots left in the first chunk go on the free list instead of being lost
+	for (int i = 0; i < 13; i++) {
+		reserved.Allocate(i);
+	}
+	REQUIRE(reserved.GetChunkCount() == 2);
+	REQUIRE(reserved.GetInUseCount() == 14);
+
+	GatorAVL heapTree(0);	// The tree should behave the same whether or not nodes come from a pool
+	GatorAVL poolTree(2);
+	for (int i = 0; i < 100; i++) {
+		heapTree.Insert("testname", to_string(99999999 - i));
+		poolTree.Insert("testname", to_string(99999999 - i));
+	}
+	for (int i = 0; i < 50; i++) {
+		heapTree.RemoveInorder(0);
+		poolTree.RemoveInorder(0);
+	}
+	REQUIRE(heapTree.GetSize() == poolTree.GetSize());
+	REQUIRE(heapTree.GetRoot()->gatorID == poolTree.GetRoot()->gatorID);
+	REQUIRE(heapTree.GetLevelCount() == poolTree.GetLevelCount());
+}
+
+TEST_CASE("Compaction") {
+	GatorAVL avlTree(4);
+
+	for (int i = 0; i < 100; i++) {
+		avlTree.Insert("testname", to_string(99999999 - i));
+	}
+	for (int i = 0; i < 30; i++) {
+		avlTree.RemoveInorder(10);
+	}
+	uint32_t rootID = avlTree.GetRoot()->gatorID;
+	int levels = avlTree.GetLevelCount();
+
+	avlTree.Compact();	// Relocating the nodes should not change the shape of the tree
+	REQUIRE(avlTree.GetSize() == 70);
+	REQUIRE(avlTree.GetRoot()->gatorID == rootID);
+	REQUIRE(avlTree.GetLevelCount() == levels);
+	REQUIRE(avlTree.GetRoot()->left->left == avlTree.GetRoot() + 3);	// Breadth-first order places the root's grandchildren right after its children
+
+	avlTree.Insert("testname", "10000000");	// The relocated tree should remain fully usable
+	avlTree.Remove("99999999");
+	REQUIRE(avlTree.GetSize() == 70);
+}
+
+TEST_CASE("Name Table") {
+	GatorNameTable names;
+
+	uint32_t jacob = names.Intern("Jacob");
+	uint32_t jack = names.Intern("Jack");
+	REQUIRE(names.Intern("Jacob") == jacob);	// Identical names should share one index
+	REQUIRE(names.GetCount() == 2);
+	REQUIRE(names.GetReferenceCount() == 3);
+	REQUIRE(names.GetDedupRatio() == 1.5);
+	REQUIRE(names.GetBytesSaved() == sizeof(string));	// "Jacob" is short enough to need no heap buffer
+
+	names.Release(jacob);
+	REQUIRE(names.Get(jacob) == "Jacob");	// One node still uses the name
+	names.Release(jacob);
+	uint32_t found;
+	REQUIRE(!names.Find("Jacob", found));
+	REQUIRE(names.Intern("Lauren") == jacob);	// Released indices should be reused
+	REQUIRE(names.Get(jack) == "Jack");
+
+	GatorAVL avlTree;
+	avlTree.Insert("Jacob", "99999999");
+	avlTree.Insert("Jack", "99999998");
+	avlTree.Insert("Jake", "99999997");
+	avlTree.Remove("99999998");		// Remove the root so its name slot is freed
+	avlTree.Insert("Dustin", "99999998");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()) == "Dustin");	// Each node should still find its own name after the rotation
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()->left) == "Jake");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()->right) == "Jacob");
+}
+
+template <typename Node>
+int CheckSubtree(Node* node, int& count) {	// Verify the stored height, subtree size and balance of every node -- returns the subtree height
+	if (!node) {
+		count = 0;
+		return 0;
+	}
+	int leftCount, rightCount;
+	int leftHeight = CheckSubtree(node->left, leftCount);
+	int rightHeight = CheckSubtree(node->right, rightCount);
+	count = leftCount + rightCount + 1;
+	REQUIRE(node->height == 1 + max(leftHeight, rightHeight));
+	REQUIRE(node->subtreeSize == count);
+	REQUIRE(abs(leftHeight - rightHeight) <= 1);
+	return node->height;
+}
+
+TEST_CASE("Subtree Sizes") {
+	GatorAVL avlTree;
+	int count;
+
+	for (int i = 0; i < 300; i++) {
+		avlTree.Insert("testname", to_string(10000000 + (i * 7919) % 300));	// Insert in a scrambled order
+	}
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 300);
+
+	for (int i = 0; i < 300; i += 3) {	// Removing nodes with two children must keep every ancestor up to date
+		avlTree.Remove(to_string(10000000 + i));
+	}
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 200);
+
+	avlTree.RemoveInorder(150);
+	avlTree.RemoveInorder(199);		// Out of bounds after the previous removal
+	for (int i = 0; i < 100; i++) {		// Queue-style removal from the front
+		avlTree.RemoveInorder(0);
+	}
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 99);
+	REQUIRE(avlTree.GetSize() == 99);
+	REQUIRE(avlTree.GetRoot()->subtreeSize == 99);
+}
+
+TEST_CASE("Rank and Select") {
+	GatorAVL avlTree;
+	GatorAVL::GatorRecord record;
+
+	REQUIRE(!avlTree.SelectByRank(0, record));	// Nothing to select in an empty tree
+	for (int i = 0; i < 100; i++) {
+		avlTree.Insert("testname", to_string(10000000 + (i * 37) % 100 * 2));	// Even IDs inserted in a scrambled order
+	}
+	avlTree.Insert("Jacob", "10000051");
+
+	REQUIRE(avlTree.SelectByRank(26, record));
+	REQUIRE(record.gatorID == 10000051);	// 26 even IDs are smaller than it
+	REQUIRE(record.name == "Jacob");
+	REQUIRE(avlTree.RankOf(10000051) == 26);
+	REQUIRE(avlTree.RankOf(10000000) == 0);
+	REQUIRE(avlTree.RankOf(10000198) == 100);
+	REQUIRE(avlTree.RankOf(10000001) == -1);	// Not in the tree
+	REQUIRE(!avlTree.SelectByRank(101, record));
+
+	for (int i = 0; i < 101; i++) {		// Every rank should map back to itself
+		avlTree.SelectByRank(i, record);
+		REQUIRE(avlTree.RankOf(record.gatorID) == i);
+	}
+}
+
+TEST_CASE("Early-Stop Retracing") {
+	GatorAVL avlTree;
+	int count;
+
+	avlTree.Insert("Jacob", "10000020");
+	avlTree.Insert("Jack", "10000010");
+	avlTree.Insert("Jake", "10000030");
+	avlTree.Insert("Lauren", "10000040");
+	REQUIRE(avlTree.GetLastTouchCount() == 2);	// Both ancestors grew taller
+
+	avlTree.Insert("Dustin", "10000050");
+	REQUIRE(avlTree.GetLastTouchCount() == 2);	// The rotation at 10000030 restores its height, so the root is never revisited
+	REQUIRE(avlTree.GetRoot()->subtreeSize == 5);	// The root's size is still updated on the way down
+	CheckSubtree(avlTree.GetRoot(), count);
+
+	avlTree.Remove("10000010");		// The root loses height on the left and has to rotate
+	REQUIRE(avlTree.GetLastTouchCount() == 1);
+	REQUIRE(avlTree.GetRoot()->gatorID == 10000040);	// The right child is balanced, so a single left rotation is enough
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 4);
+}
+
+TEST_CASE("Move-Aware Insertion") {
+	GatorAVL avlTree;
+
+	string name = "Jacob";
+	avlTree.Insert(name, "10000002");	// Lvalue names are copied into the tree and left untouched
+	REQUIRE(name == "Jacob");
+	avlTree.Insert(string("Lauren"), "10000001");
+	avlTree.EmplaceInsert("10000003", 5, 'a');	// Builds the name "aaaaa" in place
+	avlTree.EmplaceInsert("10000004", "Jacob");
+	REQUIRE(avlTree.GetSize() == 4);
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()) == "Jacob");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()->left) == "Lauren");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()->right) == "aaaaa");
+	REQUIRE(avlTree.GetName(avlTree.GetRoot()->right->right) == "Jacob");
+
+	avlTree.EmplaceInsert("10000004", "Jake");	// Duplicate IDs are still rejected
+	avlTree.Insert(string("J4ke"), "10000005");		// And so are invalid names
+	REQUIRE(avlTree.GetSize() == 4);
+}
+
+TEST_CASE("Status Codes") {
+	GatorAVL avlTree;
+
+	REQUIRE(avlTree.Insert("Jacob", "10000001") == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Insert("Jack", "10000001") == GatorAVL::GatorStatus::Duplicate);
+	REQUIRE(avlTree.Insert("J4ck", "10000002") == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Insert("Jack", "1000000") == GatorAVL::GatorStatus::Invalid);	// Too short
+	REQUIRE(avlTree.Insert("Jack", "+1000000") == GatorAVL::GatorStatus::Invalid);	// Signs are not digits
+	REQUIRE(avlTree.Insert("Jack", " 1000000") == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Insert("Jack", "1000000a") == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Insert("Jack", "00000000") == GatorAVL::GatorStatus::Successful);	// Leading zeros are allowed
+
+	REQUIRE(avlTree.Remove("10000002") == GatorAVL::GatorStatus::NotFound);
+	REQUIRE(avlTree.Remove("abcdefgh") == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Remove("00000000") == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.RemoveInorder(1) == GatorAVL::GatorStatus::NotFound);
+	REQUIRE(avlTree.RemoveInorder(0) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.GetSize() == 0);
+
+	// The versions taking a numeric gatorID report the same statuses without printing them
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	GatorAVL::GatorRecord record;
+	REQUIRE(avlTree.Insert("Jacob", 10000001) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Insert("Jack", 10000001) == GatorAVL::GatorStatus::Duplicate);
+	REQUIRE(avlTree.Insert("J4ck", 10000002) == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Insert("Jack", 100000000) == GatorAVL::GatorStatus::Invalid);	// Too long
+	REQUIRE(avlTree.Search(10000001, record));
+	REQUIRE(record.name == "Jacob");
+	REQUIRE(!avlTree.Search(10000002, record));
+	REQUIRE(avlTree.Remove(10000002) == GatorAVL::GatorStatus::NotFound);
+	REQUIRE(avlTree.Remove(100000000) == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Remove(10000001) == GatorAVL::GatorStatus::Successful);
+	LockedGatorAVL lockedTree;
+	REQUIRE(lockedTree.Insert("Jacob", 10000001) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(lockedTree.Search(10000001, record));
+	REQUIRE(lockedTree.Remove(10000001) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(!lockedTree.Search(10000001, record));
+	cout.rdbuf(saved);
+	REQUIRE(output.str().empty());
+	REQUIRE(avlTree.GetSize() == 0);
+}
+
+TEST_CASE("Name Index") {
+	GatorAVL avlTree;
+	stringstream scanOutput, indexOutput;
+	streambuf* console = cout.rdbuf();
+
+	for (int i = 0; i < 200; i++) {
+		avlTree.Insert(i % 3 == 0 ? "Jacob" : "Lauren", to_string(10000000 + (i * 7919) % 200));
+	}
+	for (int i = 0; i < 200; i += 5) {
+		avlTree.Remove(to_string(10000000 + i));
+	}
+
+	cout.rdbuf(scanOutput.rdbuf());
+	avlTree.Search("Jacob");
+	cout.rdbuf(indexOutput.rdbuf());
+	avlTree.SetNameIndex(true);		// Built from the existing tree
+	avlTree.Search("Jacob");
+	cout.rdbuf(console);
+	REQUIRE(scanOutput.str() == indexOutput.str());		// Matches should come out in the same preorder
+
+	cout.rdbuf(indexOutput.rdbuf());
+	for (int i = 0; i < 200; i += 5) {	// The index has to follow later insertions and removals
+		avlTree.Insert("Jacob", to_string(10000000 + i));
+	}
+	avlTree.RemoveInorder(7);
+	avlTree.RemoveInorder(70);
+	avlTree.Remove(to_string(10000000 + 33));
+	scanOutput.str("");
+	indexOutput.str("");
+	avlTree.Search("Jacob");
+	cout.rdbuf(scanOutput.rdbuf());
+	avlTree.SetNameIndex(false);
+	avlTree.Search("Jacob");
+	cout.rdbuf(console);
+	REQUIRE(scanOutput.str() == indexOutput.str());
+	REQUIRE(!scanOutput.str().empty());
+}
+
+TEST_CASE("Prefix Search") {
+	GatorAVL avlTree;
+
+	avlTree.Insert("Jacob", "10000004");
+	avlTree.Insert("Jack", "10000002");
+	avlTree.Insert("Lauren", "10000003");
+	avlTree.Insert("Jake", "10000001");
+	avlTree.Insert("J", "10000005");
+	avlTree.Insert("Jacob", "10000006");
+
+	vector<uint32_t> expected = { 10000002, 10000004, 10000006 };
+	REQUIRE(avlTree.FindPrefix("Jac") == expected);		// Scanning the tree
+	avlTree.SetNameIndex(true);
+	REQUIRE(avlTree.FindPrefix("Jac") == expected);		// Using the name index
+
+	expected = { 10000001, 10000002, 10000004, 10000005, 10000006 };
+	REQUIRE(avlTree.FindPrefix("J") == expected);
+	REQUIRE(avlTree.FindPrefix("").size() == 6);	// Every name starts with the empty prefix
+	REQUIRE(avlTree.FindPrefix("Jz").empty());
+	REQUIRE(avlTree.FindPrefix("Lauren Smith").empty());	// Longer than every matching name
+}
+
+TEST_CASE("Bulk Load") {
+	GatorAVL avlTree;
+	int count;
+
+	vector<pair<string, string>> records;
+	for (int i = 0; i < 1000; i++) {
+		records.push_back(make_pair("testname", to_string(10000000 + i)));
+	}
+	vector<GatorAVL::GatorStatus> statuses = avlTree.BulkLoad(records);
+	REQUIRE(statuses.size() == 1000);
+	REQUIRE(count_if(statuses.begin(), statuses.end(), [](GatorAVL::GatorStatus status) { return status == GatorAVL::GatorStatus::Successful; }) == 1000);
+	REQUIRE(avlTree.GetSize() == 1000);
+	REQUIRE(avlTree.GetLevelCount() == 10);		// A perfectly balanced tree of 1000 nodes
+	CheckSubtree(avlTree.GetRoot(), count);
+
+	GatorAVL unsortedTree;
+	records = { { "Jacob", "10000003" }, { "Jack", "10000001" }, { "Jake", "10000003" }, { "L4uren", "10000004" }, { "Dustin", "1000002" }, { "Gabriel", "10000002" } };
+	statuses = unsortedTree.BulkLoad(records);
+	vector<GatorAVL::GatorStatus> expected = { GatorAVL::GatorStatus::Successful, GatorAVL::GatorStatus::Successful, GatorAVL::GatorStatus::Duplicate,
+		GatorAVL::GatorStatus::Invalid, GatorAVL::GatorStatus::Invalid, GatorAVL::GatorStatus::Successful };
+	REQUIRE(statuses == expected);
+	REQUIRE(unsortedTree.GetSize() == 3);
+	REQUIRE(unsortedTree.GetName(unsortedTree.GetRoot()) == "Gabriel");
+	REQUIRE(unsortedTree.GetName(unsortedTree.GetRoot()->right) == "Jacob");	// The first of the duplicate IDs is the one kept
+	CheckSubtree(unsortedTree.GetRoot(), count);
+
+	statuses = unsortedTree.BulkLoad({ { "Lauren", "10000004" }, { "Jake", "10000001" } });		// Loading into a non-empty tree
+	REQUIRE(statuses[0] == GatorAVL::GatorStatus::Successful);
+	REQUIRE(statuses[1] == GatorAVL::GatorStatus::Duplicate);
+	REQUIRE(unsortedTree.GetSize() == 4);
+}
+
+TEST_CASE("Batch Insert") {
+	GatorAVL avlTree;
+	int count;
+
+	for (int i = 0; i < 500; i++) {
+		avlTree.Insert("testname", to_string(10000000 + i * 2));	// Even gatorIDs only
+	}
+	vector<pair<string, uint32_t>> batch;
+	for (int i = 999; i >= 0; i -= 3) {		// Unsorted, and every other record collides with the tree
+		batch.push_back(make_pair("batchname", 10000000 + i));
+	}
+	batch.push_back(make_pair("batchname", 10000003));		// Collides with an earlier record of the batch
+	batch.push_back(make_pair("B4tchname", 10000007));
+	batch.push_back(make_pair("batchname", 100000000));		// Nine digits
+	vector<GatorAVL::GatorStatus> statuses = avlTree.InsertBatch(batch);
+	REQUIRE(statuses.size() == batch.size());
+	int inserted = 0;
+	for (int i = 0; i < batch.size() - 3; i++) {
+		if (batch[i].second % 2 == 0) {
+			REQUIRE(statuses[i] == GatorAVL::GatorStatus::Duplicate);
+		}
+		else {
+			REQUIRE(statuses[i] == GatorAVL::GatorStatus::Successful);
+			inserted++;
+		}
+	}
+	REQUIRE(statuses[batch.size() - 3] == GatorAVL::GatorStatus::Duplicate);
+	REQUIRE(statuses[batch.size() - 2] == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(statuses[batch.size() - 1] == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.GetSize() == 500 + inserted);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 500 + inserted);
+
+	GatorAVL::GatorRecord record;
+	REQUIRE(avlTree.SelectByRank(0, record));
+	REQUIRE(record.name == "testname");		// The tree keeps its own record when the batch collides with it
+	REQUIRE(avlTree.SelectByRank(2, record));
+	REQUIRE(record.name == "batchname");
+	REQUIRE(record.gatorID == 10000003);
+
+	// Batches much smaller and much larger than the tree both stay balanced
+	GatorAVL mixedTree;
+	srand(3530);
+	int expectedSize = 0;
+	for (int round = 0; round < 20; round++) {
+		batch.clear();
+		int batchSize = round % 2 == 0 ? 3 : 400;
+		for (int i = 0; i < batchSize; i++) {
+			batch.push_back(make_pair("testname", 10000000 + rand() % 5000));
+		}
+		statuses = mixedTree.InsertBatch(batch);
+		expectedSize += count_if(statuses.begin(), statuses.end(), [](GatorAVL::GatorStatus status) { return status == GatorAVL::GatorStatus::Successful; });
+		CheckSubtree(mixedTree.GetRoot(), count);
+		REQUIRE(count == expectedSize);
+		REQUIRE(mixedTree.GetSize() == expectedSize);
+	}
+
+	// A rejected duplicate with the same name leaves the name index entry of the record it collided with
+	GatorAVL indexedTree;
+	indexedTree.SetNameIndex(true);
+	indexedTree.Insert("Bob", "11111111");
+	statuses = indexedTree.InsertBatch({ make_pair(string("Bob"), 11111111u), make_pair(string("Bob"), 11111112u), make_pair(string("Al"), 11111113u) });
+	REQUIRE(statuses == vector<GatorAVL::GatorStatus>({ GatorAVL::GatorStatus::Duplicate, GatorAVL::GatorStatus::Successful, GatorAVL::GatorStatus::Successful }));
+	REQUIRE(indexedTree.FindPrefix("Bob") == vector<uint32_t>({ 11111111, 11111112 }));
+	REQUIRE(indexedTree.FindPrefix("Al") == vector<uint32_t>({ 11111113 }));
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	indexedTree.Search("Bob");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "11111112\n11111111\n");	// Preorder, with both records still found through the index
+}
+
+TEST_CASE("Split and Join") {
+	GatorAVL avlTree;
+	int count;
+
+	for (int i = 0; i < 1000; i++) {
+		avlTree.Insert(i % 2 == 0 ? "Even" : "Odd", to_string(10000000 + i));
+	}
+	GatorAVL upper;
+	REQUIRE(avlTree.Split(10000600, upper) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.GetSize() == 600);
+	REQUIRE(upper.GetSize() == 400);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 600);
+	CheckSubtree(upper.GetRoot(), count);
+	REQUIRE(count == 400);
+	REQUIRE(avlTree.RankOf(10000599) == 599);
+	REQUIRE(avlTree.RankOf(10000600) == -1);
+	REQUIRE(upper.RankOf(10000600) == 0);	// The split point goes to the upper tree
+	REQUIRE(avlTree.Split(10000100, upper) == GatorAVL::GatorStatus::Invalid);	// upper is not empty
+
+	GatorAVL empty;
+	REQUIRE(upper.Split(10000000, empty) == GatorAVL::GatorStatus::Successful);	// Every gatorID is >= the split point
+	REQUIRE(upper.GetSize() == 0);
+	REQUIRE(empty.GetSize() == 400);
+	REQUIRE(upper.Join(empty) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(upper.GetSize() == 400);
+	REQUIRE(empty.GetSize() == 0);
+
+	REQUIRE(upper.Join(avlTree) == GatorAVL::GatorStatus::Invalid);		// avlTree's gatorIDs are smaller than upper's
+	upper.Remove("10000700");	// Removing from either side still works on the shared storage
+	upper.Insert("Extra", "10005000");
+	REQUIRE(avlTree.Join(upper) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.GetSize() == 1000);
+	REQUIRE(upper.GetSize() == 0);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 1000);
+	REQUIRE(avlTree.RankOf(10005000) == 999);
+	GatorAVL::GatorRecord record;
+	REQUIRE(avlTree.SelectByRank(601, record));
+	REQUIRE(record.name == "Odd");
+
+	// Trees with their own storage are joined by copying the upper tree's records
+	GatorAVL heapTree(0);
+	heapTree.SetNameIndex(true);
+	heapTree.Insert("Lauren", "20000000");
+	heapTree.Insert("Even", "20000001");
+	REQUIRE(avlTree.Join(heapTree) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.GetSize() == 1002);
+	REQUIRE(heapTree.GetSize() == 0);
+	REQUIRE(avlTree.SelectByRank(1000, record));
+	REQUIRE(record.name == "Lauren");
+	CheckSubtree(avlTree.GetRoot(), count);
+
+	// Splitting a tree with the name index keeps each side's index to its own records
+	avlTree.SetNameIndex(true);
+	GatorAVL indexed;
+	indexed.SetNameIndex(true);
+	avlTree.Split(10000002, indexed);
+	REQUIRE(avlTree.FindPrefix("Ev") == vector<uint32_t>{ 10000000 });
+	REQUIRE(indexed.FindPrefix("Lau") == vector<uint32_t>{ 20000000 });
+
+	// A name interned by the other side of a split has no slot in this side's index
+	REQUIRE(avlTree.Insert("Zed", "00000001") == GatorAVL::GatorStatus::Successful);
+	REQUIRE(indexed.FindPrefix("Z").empty());
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	indexed.Search("Zed");
+	indexed.SearchPrefix("Z");
+	avlTree.Search("Zed");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "unsuccessful\nunsuccessful\n00000001\n");
+
+	// Without shared storage the upper half is copied, so each half can be updated on its own thread
+	GatorAVL lowerShard;
+	GatorAVL upperShard;
+	for (int i = 0; i < 2000; i++) {
+		lowerShard.InsertBatch({ { i % 2 == 0 ? "Even" : "Odd", 30000000 + i } });
+	}
+	upperShard.SetNameIndex(true);
+	REQUIRE(lowerShard.Split(30001000, upperShard) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(lowerShard.Join(upperShard) == GatorAVL::GatorStatus::Successful);	// upperShard is empty again but still shares lowerShard's storage
+	REQUIRE(lowerShard.Split(30001000, upperShard, false) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(upperShard.GetSize() == 1000);
+	REQUIRE(upperShard.FindPrefix("Ev").size() == 500);
+	thread lowerWriter([&lowerShard] {
+		for (int i = 0; i < 1000; i++) {
+			lowerShard.RemoveRange(30000000 + i, 30000000 + i);
+			lowerShard.InsertBatch({ { "Lower", (uint32_t)30000000 + i } });
+		}
+	});
+	for (int i = 1000; i < 2000; i++) {
+		upperShard.RemoveRange(30000000 + i, 30000000 + i);
+		upperShard.InsertBatch({ { "Upper", (uint32_t)30000000 + i } });
+	}
+	lowerWriter.join();
+	REQUIRE(lowerShard.GetSize() == 1000);
+	REQUIRE(upperShard.GetSize() == 1000);
+	CheckSubtree(upperShard.GetRoot(), count);
+	REQUIRE(count == 1000);
+	REQUIRE(upperShard.FindPrefix("Upper").size() == 1000);
+	REQUIRE(upperShard.FindPrefix("Ev").empty());
+	REQUIRE(lowerShard.SelectByRank(999, record));
+	REQUIRE(record.name == "Lower");
+}
+
+TEST_CASE("Range Search") {
+	GatorAVL avlTree;
+
+	for (int i = 0; i < 1000; i++) {
+		avlTree.Insert(i % 2 == 0 ? "Even" : "Odd", to_string(10000000 + i * 10));
+	}
+	vector<uint32_t> gatorIDs;
+	vector<string> names;
+	avlTree.ForEachInRange(10000095, 10000130, [&](uint32_t gatorID, const string& name) {
+		gatorIDs.push_back(gatorID);
+		names.push_back(name);
+	});
+	REQUIRE(gatorIDs == vector<uint32_t>{ 10000100, 10000110, 10000120, 10000130 });	// Both bounds are inclusive
+	REQUIRE(names == vector<string>{ "Even", "Odd", "Even", "Odd" });
+
+	int count = 0;
+	avlTree.ForEachInRange(0, 99999999, [&count](uint32_t, const string&) { count++; });
+	REQUIRE(count == 1000);
+	count = 0;
+	avlTree.ForEachInRange(10000001, 10000009, [&count](uint32_t, const string&) { count++; });	// Falls between two records
+	REQUIRE(count == 0);
+	avlTree.ForEachInRange(10000500, 10000400, [&count](uint32_t, const string&) { count++; });	// An empty range
+	REQUIRE(count == 0);
+
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	avlTree.SearchRange("10009980", "99999999");
+	avlTree.SearchRange("10000001", "10000009");
+	avlTree.SearchRange("1000", "10000009");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "10009980\n10009990\nunsuccessful\nunsuccessful\n");
+}
+
+TEST_CASE("Range Removal") {
+	GatorAVL avlTree;
+	int count;
+
+	avlTree.SetNameIndex(true);
+	for (int i = 0; i < 1000; i++) {
+		avlTree.Insert(i < 500 ? "Early" : "Late", to_string(10000000 + i * 10));
+	}
+	REQUIRE(avlTree.RemoveRange(10000095, 10003000) == 291);	// 10000100 through 10003000, both bounds inclusive
+	REQUIRE(avlTree.GetSize() == 709);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 709);
+	REQUIRE(avlTree.RankOf(10000090) == 9);
+	REQUIRE(avlTree.RankOf(10003010) == 10);
+	REQUIRE(avlTree.RemoveRange(10000095, 10003000) == 0);
+	REQUIRE(avlTree.RemoveRange(10005000, 10004000) == 0);	// low above high
+
+	REQUIRE(avlTree.RemoveRange(10005000, 99999999) == 500);	// Every "Late" record
+	REQUIRE(avlTree.FindPrefix("La").empty());		// The name index forgets the removed records
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 209);
+
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	avlTree.RemoveRange("10000000", "10000000");
+	avlTree.RemoveRange("10000000", "10000000");
+	avlTree.RemoveRange("1000", "10000000");
+	avlTree.RemoveRange("00000000", "99999999");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "successful\nunsuccessful\nunsuccessful\nsuccessful\n");
+	REQUIRE(avlTree.GetSize() == 0);
+	REQUIRE(avlTree.GetRoot() == nullptr);
+}
+
+TEST_CASE("Range Count") {
+	GatorAVL avlTree;
+
+	REQUIRE(avlTree.CountRange(0, 99999999) == 0);
+	srand(3530);
+	for (int i = 0; i < 2000; i++) {
+		avlTree.Insert("testname", to_string(10000000 + rand() % 10000));
+	}
+	for (int i = 0; i < 200; i++) {		// Compare against counting the range record by record
+		uint32_t low = 10000000 + rand() % 10000;
+		uint32_t high = low + rand() % 3000;
+		int expected = 0;
+		avlTree.ForEachInRange(low, high, [&expected](uint32_t, const string&) { expected++; });
+		REQUIRE(avlTree.CountRange(low, high) == expected);
+	}
+	REQUIRE(avlTree.CountRange(0, 99999999) == avlTree.GetSize());
+	REQUIRE(avlTree.CountRange(10005000, 10004000) == 0);
+
+	GatorAVL smallTree;
+	smallTree.Insert("Jacob", "10000010");
+	smallTree.Insert("Jack", "10000020");
+	smallTree.Insert("Jake", "10000030");
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	smallTree.PrintCountRange("10000010", "10000030");
+	smallTree.PrintCountRange("10000011", "10000029");
+	smallTree.PrintCountRange("10000031", "99999999");
+	smallTree.PrintCountRange("1000001", "10000030");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "3\n1\n0\nunsuccessful\n");
+}
+
+TEST_CASE("Nearest Records") {
+	GatorAVL avlTree;
+	GatorAVL::GatorRecord record;
+
+	REQUIRE(!avlTree.LowerBound(10000000, record));
+	for (int i = 1; i <= 100; i++) {
+		avlTree.Insert(i == 50 ? "Middle" : "testname", to_string(10000000 + i * 10));
+	}
+	REQUIRE(avlTree.LowerBound(10000500, record));
+	REQUIRE(record.gatorID == 10000500);
+	REQUIRE(record.name == "Middle");
+	REQUIRE(avlTree.LowerBound(10000495, record));
+	REQUIRE(record.gatorID == 10000500);
+	REQUIRE(avlTree.UpperBound(10000500, record));
+	REQUIRE(record.gatorID == 10000510);
+	REQUIRE(avlTree.Successor(10000495, record));
+	REQUIRE(record.gatorID == 10000500);
+	REQUIRE(avlTree.Predecessor(10000500, record));
+	REQUIRE(record.gatorID == 10000490);
+	REQUIRE(avlTree.Predecessor(10000505, record));
+	REQUIRE(record.gatorID == 10000500);
+	REQUIRE(!avlTree.Predecessor(10000010, record));	// Past either end of the tree
+	REQUIRE(!avlTree.UpperBound(10001000, record));
+	REQUIRE(avlTree.LowerBound(10001000, record));
+	REQUIRE(!avlTree.LowerBound(10001001, record));
+
+	uint32_t gatorID = 0;	// Walking with Successor() visits every record in order
+	int count = 0;
+	while (avlTree.Successor(gatorID, record)) {
+		REQUIRE(record.gatorID > gatorID);
+		gatorID = record.gatorID;
+		count++;
+	}
+	REQUIRE(count == 100);
+
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	avlTree.PrintLowerBound("10000015");
+	avlTree.PrintUpperBound("10000020");
+	avlTree.PrintPredecessor("10000020");
+	avlTree.PrintSuccessor("10001000");
+	avlTree.PrintLowerBound("1000001");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "10000020\n10000030\n10000010\nunsuccessful\nunsuccessful\n");
+}
+
+TEST_CASE("Finger Search") {
+	GatorAVL avlTree;
+	int count;
+
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	for (int i = 2000; i > 0; i--) {	// Descending, like Big Tree
+		avlTree.FingerInsert("testname", to_string(10000000 + i * 2));
+	}
+	for (int i = 0; i < 1000; i++) {	// Ascending into the gaps, with an ordinary insertion now and then invalidating the finger
+		avlTree.FingerInsert("testname", to_string(10000001 + i * 2));
+		if (i % 100 == 0) {
+			avlTree.Insert("other", to_string(20000000 + i));
+		}
+	}
+	avlTree.FingerInsert("testname", "10000002");	// Duplicate
+	avlTree.FingerInsert("testname", "1000002");	// Invalid
+	cout.rdbuf(saved);
+	REQUIRE(avlTree.GetSize() == 3010);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == 3010);
+	string statuses = output.str();
+	REQUIRE(statuses.substr(statuses.size() - 26) == "unsuccessful\nunsuccessful\n");
+
+	GatorAVL::GatorRecord record;
+	srand(3530);
+	for (int i = 0; i < 2000; i++) {	// Random jumps and short steps, checked against RankOf()
+		uint32_t gatorID = i % 3 == 0 ? 10000000 + rand() % 5000 : record.gatorID + 1;
+		bool found = avlTree.FingerSearch(gatorID, record);
+		REQUIRE(found == (avlTree.RankOf(gatorID) >= 0));
+		if (!found) {
+			record.gatorID = gatorID;
+		}
+	}
+	REQUIRE(avlTree.FingerSearch(20000500, record));
+	REQUIRE(record.name == "other");
+	avlTree.Remove("20000500");
+	REQUIRE(!avlTree.FingerSearch(20000500, record));	// The removal invalidated the finger
+	REQUIRE(avlTree.FingerSearch(20000600, record));
+}
+
+TEST_CASE("Set Operations") {
+	int count;
+
+	for (int threads = 1; threads <= 4; threads += 3) {
+		for (int operation = 0; operation < 3; operation++) {
+			GatorAVL registrar;
+			GatorAVL housing(0);	// Separate storage, so housing's records are copied in first
+			set<uint32_t> registrarIDs;
+			set<uint32_t> housingIDs;
+			srand(3530 + operation);
+			vector<pair<string, uint32_t>> batch;
+			for (int i = 0; i < 20000; i++) {
+				batch.push_back(make_pair("Registrar", 10000000 + rand() % 40000));
+				registrarIDs.insert(batch.back().second);
+			}
+			registrar.InsertBatch(batch);
+			batch.clear();
+			for (int i = 0; i < 20000; i++) {
+				batch.push_back(make_pair("Housing", 10000000 + rand() % 40000));
+				housingIDs.insert(batch.back().second);
+			}
+			housing.InsertBatch(batch);
+
+			set<uint32_t> expected;
+			if (operation == 0) {
+				REQUIRE(registrar.Union(housing, threads) == GatorAVL::GatorStatus::Successful);
+				set_union(registrarIDs.begin(), registrarIDs.end(), housingIDs.begin(), housingIDs.end(), inserter(expected, expected.end()));
+			}
+			else if (operation == 1) {
+				REQUIRE(registrar.Intersection(housing, threads) == GatorAVL::GatorStatus::Successful);
+				set_intersection(registrarIDs.begin(), registrarIDs.end(), housingIDs.begin(), housingIDs.end(), inserter(expected, expected.end()));
+			}
+			else {
+				REQUIRE(registrar.Difference(housing, threads) == GatorAVL::GatorStatus::Successful);
+				set_difference(registrarIDs.begin(), registrarIDs.end(), housingIDs.begin(), housingIDs.end(), inserter(expected, expected.end()));
+			}
+			REQUIRE(housing.GetSize() == 0);
+			REQUIRE(registrar.GetSize() == expected.size());
+			CheckSubtree(registrar.GetRoot(), count);
+			REQUIRE(count == expected.size());
+			vector<uint32_t> gatorIDs;
+			bool registrarWins = true;	// Records in both trees keep registrar's name
+			registrar.ForEachInRange(0, 99999999, [&](uint32_t gatorID, const string& name) {
+				gatorIDs.push_back(gatorID);
+				if (registrarIDs.count(gatorID) && name != "Registrar") {
+					registrarWins = false;
+				}
+			});
+			REQUIRE(gatorIDs == vector<uint32_t>(expected.begin(), expected.end()));
+			REQUIRE(registrarWins);
+		}
+	}
+
+	GatorAVL avlTree;
+	avlTree.SetNameIndex(true);
+	avlTree.InsertBatch({ { "Jacob", 10000001 }, { "Jack", 10000002 } });
+	GatorAVL other;
+	avlTree.Split(10000002, other);		// Shared storage, so no records are copied
+	other.InsertBatch({ { "Lauren", 10000001 }, { "Dustin", 10000003 } });
+	REQUIRE(avlTree.Union(other, 2) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.GetSize() == 3);
+	REQUIRE(avlTree.FindPrefix("J") == vector<uint32_t>{ 10000001, 10000002 });
+	REQUIRE(avlTree.FindPrefix("Lauren").empty());
+	REQUIRE(avlTree.Union(avlTree) == GatorAVL::GatorStatus::Invalid);
+
+	// A tree that shares storage from the start gives its nodes up without copying them
+	GatorAVL sharing;
+	sharing.SetNameIndex(true);
+	REQUIRE(sharing.ShareStorage(avlTree) == GatorAVL::GatorStatus::Successful);
+	sharing.InsertBatch({ { "Lauren", 10000009 } });
+	REQUIRE(sharing.FindPrefix("Lau") == vector<uint32_t>{ 10000009 });
+	REQUIRE(sharing.ShareStorage(avlTree) == GatorAVL::GatorStatus::Invalid);	// No longer empty
+	auto moved = sharing.GetRoot();
+	REQUIRE(avlTree.Union(sharing) == GatorAVL::GatorStatus::Successful);
+	auto node = avlTree.GetRoot();
+	while (node && node->gatorID != 10000009) {
+		node = 10000009 < node->gatorID ? node->left : node->right;
+	}
+	REQUIRE(node == moved);
+	REQUIRE(avlTree.FindPrefix("Lau") == vector<uint32_t>{ 10000009 });
+}
+
+TEST_CASE("Snapshots") {
+	int count;
+
+	// Compare versions taken between random updates with copies of a model taken at the same time
+	GatorAVL avlTree(0);	// Heap nodes, so any node the versions fail to release shows up as a leak
+	map<uint32_t, string> model;
+	vector<shared_ptr<const GatorAVL::Version>> versions;
+	vector<map<uint32_t, string>> expected;
+	stringstream output;
+	streambuf* saved = cout.rdbuf(output.rdbuf());
+	srand(3530);
+	for (int i = 0; i < 3000; i++) {
+		uint32_t gatorID = 10000000 + rand() % 1000;
+		int operation = rand() % 10;
+		if (operation < 5) {
+			string name = rand() % 2 ? "Jacob" : "Lauren";
+			if (avlTree.Insert(name, to_string(gatorID)) == GatorAVL::GatorStatus::Successful) {
+				model[gatorID] = name;
+			}
+		}
+		else if (operation < 8) {
+			avlTree.Remove(to_string(gatorID));
+			model.erase(gatorID);
+		}
+		else if (operation == 8) {
+			avlTree.RemoveRange(gatorID, gatorID + 5);
+			model.erase(model.lower_bound(gatorID), model.upper_bound(gatorID + 5));
+		}
+		else {
+			avlTree.FingerInsert("Dustin", to_string(gatorID));
+			model.insert(make_pair(gatorID, "Dustin"));
+		}
+		if (i % 250 == 0) {
+			versions.push_back(avlTree.Snapshot());
+			expected.push_back(model);
+		}
+		if (i % 700 == 0 && versions.size() > 2) {		// Drop an old version while the tree keeps changing
+			versions.erase(versions.begin() + 1);
+			expected.erase(expected.begin() + 1);
+		}
+	}
+	cout.rdbuf(saved);
+	CheckSubtree(avlTree.GetRoot(), count);
+	REQUIRE(count == model.size());
+	for (int i = 0; i < versions.size(); i++) {
+		map<uint32_t, string> contents;
+		versions[i]->ForEachInRange(0, 99999999, [&contents](uint32_t gatorID, const string& name) { contents[gatorID] = name; });
+		REQUIRE(contents == expected[i]);
+		REQUIRE(versions[i]->GetSize() == expected[i].size());
+	}
+	GatorAVL::GatorRecord record;
+	REQUIRE(versions[0]->Find(expected[0].begin()->first, record));
+	REQUIRE(record.name == expected[0].begin()->second);
+
+	versions.resize(2);
+	avlTree.Insert("Jake", "20000000");		// The next update releases the dropped versions
+	REQUIRE(avlTree.GetVersionCount() == 2);
+
+	// A version keeps its nodes after the tree is gone, and can be read and dropped on another thread
+	shared_ptr<const GatorAVL::Version> survivor;
+	{
+		GatorAVL pooledTree;
+		pooledTree.SetNameIndex(true);
+		for (int i = 0; i < 100; i++) {
+			pooledTree.Insert("testname", to_string(10000000 + i));
+		}
+		survivor = pooledTree.Snapshot();
+		atomic<bool> writing(true);
+		atomic<int> badWalks(0);
+		thread reader([&survivor, &writing, &badWalks] {
+			do {	// Walk until the writer is done, checking every name the version holds
+				int visited = 0;
+				survivor->ForEachInRange(0, 99999999, [&visited, &badWalks](uint32_t, const string& name) {
+					if (name != "testname") {
+						badWalks++;
+					}
+					visited++;
+				});
+				if (visited != 100) {
+					badWalks++;
+				}
+			} while (writing);
+		});
+		for (int i = 0; i < 100; i += 2) {
+			pooledTree.Remove(to_string(10000000 + i));
+			pooledTree.Insert("testname", to_string(20000000 + i));
+		}
+		for (int i = 0; i < 3000; i++) {	// New names fill more than one chunk of the name table while the reader runs
+			string name = "new";
+			for (int digits = i; digits > 0; digits /= 26) {
+				name += (char)('a' + digits % 26);
+			}
+			pooledTree.Insert(name, to_string(30000000 + i));
+		}
+		writing = false;
+		reader.join();
+		REQUIRE(badWalks == 0);
+		REQUIRE(pooledTree.FindPrefix("test").size() == 100);
+		REQUIRE(pooledTree.FindPrefix("new").size() == 3000);
+		REQUIRE(pooledTree.RankOf(10000000) == -1);
+		pooledTree.Compact();	// Skipped while a version points at the nodes
+		CheckSubtree(pooledTree.GetRoot(), count);
+	}
+	REQUIRE(survivor->Find(10000000, record));
+	REQUIRE(survivor->GetSize() == 100);
+	thread([survivor = move(survivor)] {}).join();
+
+	// A version keeps a name interned after the tree drops its last record with it, so a rebuilt name index has no slot for it
+	GatorAVL indexedTree;
+	indexedTree.Insert("Jacob", "10000000");
+	indexedTree.Insert("Solo", "10000001");		// Interned last, so it has the largest index in the table
+	shared_ptr<const GatorAVL::Version> keeper = indexedTree.Snapshot();
+	indexedTree.Remove("10000001");
+	indexedTree.SetNameIndex(true);
+	REQUIRE(indexedTree.FindPrefix("So").empty());
+	output.str("");
+	saved = cout.rdbuf(output.rdbuf());
+	indexedTree.Search("Solo");
+	indexedTree.Search("Jacob");
+	cout.rdbuf(saved);
+	REQUIRE(output.str() == "unsuccessful\n10000000\n");
+	REQUIRE(keeper->Find(10000001, record));
+	REQUIRE(record.name == "Solo");
+}
+
+TEST_CASE("Locked Tree") {
+	// A writer that is waiting keeps new readers out until it is done
+	GatorRWLock lock;
+	mutex orderLock;
+	vector<string> order;
+	lock.lock_shared();
+	thread writer([&] {
+		lock.lock();
+		{
+			lock_guard<mutex> guard(orderLock);
+			order.push_back("writer");
+		}
+		lock.unlock();
+	});
+	this_thread::sleep_for(chrono::milliseconds(100));	// Give the writer time to start waiting
+	thread reader([&] {
+		lock.lock_shared();
+		{
+			lock_guard<mutex> guard(orderLock);
+			order.push_back("reader");
+		}
+		lock.unlock_shared();
+	});
+	this_thread::sleep_for(chrono::milliseconds(100));
+	{
+		lock_guard<mutex> guard(orderLock);
+		REQUIRE(order.empty());
+	}
+	lock.unlock_shared();
+	writer.join();
+	reader.join();
+	REQUIRE(order == vector<string>({ "writer", "reader" }));
+
+	// Readers and writers on one tree
+	LockedGatorAVL avlTree;
+	atomic<bool> done(false);
+	atomic<int> badReads(0);
+	vector<thread> readers;
+	for (int r = 0; r < 4; r++) {
+		readers.push_back(thread([&avlTree, &done, &badReads, r] {
+			for (unsigned int i = r; !done; i += 4) {
+				uint32_t gatorID = 10000000 + i * 7919 % 4000;
+				GatorAVL::GatorRecord record;
+				if (avlTree.LowerBound(gatorID, record) && (record.gatorID < gatorID || record.name != "testname")) {
+					badReads++;
+				}
+				uint32_t previous = 0;
+				avlTree.ForEachInRange(gatorID, gatorID + 100, [&previous, &badReads](uint32_t gatorID, const string&) {	// Records visited under one lock stay in order
+					if (gatorID <= previous) {
+						badReads++;
+					}
+					previous = gatorID;
+				});
+			}
+		}));
+	}
+	vector<thread> writers;
+	for (int w = 0; w < 2; w++) {
+		writers.push_back(thread([&avlTree, w] {	// Each writer owns every other block of 1000 gatorIDs
+			for (int i = 0; i < 1000; i++) {
+				avlTree.InsertBatch({ make_pair(string("testname"), (uint32_t)(10000000 + w * 1000 + i)) });
+				avlTree.InsertBatch({ make_pair(string("testname"), (uint32_t)(10002000 + w * 1000 + i)) });
+			}
+			for (int i = 0; i < 1000; i += 2) {
+				avlTree.RemoveRange(10000000 + w * 1000 + i, 10000000 + w * 1000 + i);
+				avlTree.RemoveRange(10002000 + w * 1000 + i, 10002000 + w * 1000 + i);
+			}
+		}));
+	}
+	for (int w = 0; w < 2; w++) {
+		writers[w].join();
+	}
+	done = true;
+	for (int r = 0; r < 4; r++) {
+		readers[r].join();
+	}
+	REQUIRE(badReads == 0);
+	REQUIRE(avlTree.GetSize() == 2000);
+	REQUIRE(avlTree.RankOf(10000001) == 0);
+	REQUIRE(avlTree.RankOf(10000002) == -1);
+	GatorAVL::GatorRecord record;
+	REQUIRE(avlTree.SelectByRank(1999, record));
+	REQUIRE(record.gatorID == 10003999);
+	REQUIRE(avlTree.CountRange(10000000, 10003999) == 2000);
+}
+
+TEST_CASE("Concurrent Tree") {
+	ConcurrentGatorAVL avlTree;
+	GatorAVL::GatorRecord record;
+	REQUIRE(avlTree.Insert("Jake", 10000010) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Insert("Jacob", 10000005) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Insert("Dustin", 10000020) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Insert("Dustin", 10000020) == GatorAVL::GatorStatus::Duplicate);
+	REQUIRE(avlTree.Insert("Dustin2", 10000030) == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Insert("Dustin", 100000000) == GatorAVL::GatorStatus::Invalid);
+	REQUIRE(avlTree.Search(10000005, record));
+	REQUIRE(record.name == "Jacob");
+	REQUIRE(!avlTree.Search(10000006, record));
+
+	// The root has two children, so removing it leaves a routing node that a later insert can reuse
+	REQUIRE(avlTree.Remove(10000010) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Remove(10000010) == GatorAVL::GatorStatus::NotFound);
+	REQUIRE(!avlTree.Search(10000010, record));
+	REQUIRE(avlTree.GetSize() == 2);
+	REQUIRE(avlTree.Insert("Jack", 10000010) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Search(10000010, record));
+	REQUIRE(record.name == "Jack");
+	REQUIRE(avlTree.Remove(10000005) == GatorAVL::GatorStatus::Successful);
+	REQUIRE(avlTree.Remove(10000010) == GatorAVL::GatorStatus::Successful);	// Now a leaf's only sibling is gone, so the routing node can be unlinked
+	REQUIRE(avlTree.GetSize() == 1);
+	REQUIRE(avlTree.GetLevelCount() == 1);
+
+	// Writers own every fourth gatorID and insert them all, then remove every other one, while readers check what they find
+	const int count = 20000;
+	atomic<bool> done(false);
+	atomic<int> badReads(0);
+	vector<thread> readers;
+	for (int r = 0; r < 2; r++) {
+		readers.push_back(thread([&avlTree, &done, &badReads, r] {
+			GatorAVL::GatorRecord record;
+			for (unsigned int i = r; !done; i += 2) {
+				uint32_t gatorID = 20000000 + i * 7919 % count;
+				if (avlTree.Search(gatorID, record) && (record.gatorID != gatorID || record.name != string(1, 'a' + gatorID % 4))) {
+					badReads++;
+				}
+			}
+		}));
+	}
+	vector<thread> writers;
+	for (int w = 0; w < 4; w++) {
+		writers.push_back(thread([&avlTree, w] {
+			string name(1, 'a' + w);
+			for (int i = w; i < count; i += 4) {
+				avlTree.Insert(name, 20000000 + i);
+			}
+			for (int i = w; i < count; i += 8) {
+				avlTree.Remove(20000000 + i);
+			}
+		}));
+	}
+	for (int w = 0; w < 4; w++) {
+		writers[w].join();
+	}
+	done = true;
+	for (int r = 0; r < 2; r++) {
+		readers[r].join();
+	}
+	REQUIRE(badReads == 0);
+	REQUIRE(avlTree.GetSize() == count / 2 + 1);
+	int visited = 0;
+	uint32_t previous = 0;
+	bool ordered = true;
+	avlTree.ForEachInRange(20000000, 29999999, [&visited, &previous, &ordered](uint32_t gatorID, const string&) {
+		ordered = ordered && gatorID > previous && (gatorID - 20000000) % 8 >= 4;
+		previous = gatorID;
+		visited++;
+	});
+	REQUIRE(ordered);
+	REQUIRE(visited == count / 2);
+	REQUIRE(avlTree.GetLevelCount() <= 2 * log2(count));	// Routing nodes left by removals make it taller than a strict AVL tree of count / 2 records
+	REQUIRE(avlTree.Search(20000004, record));
+	REQUIRE(!avlTree.Search(20000008, record));
+
+	// Walks that race rotations can miss records, but must still pass each one in ascending order and only once
+	done = false;
+	atomic<int> badWalks(0);
+	thread walker([&avlTree, &done, &badWalks] {
+		while (!done) {
+			uint32_t previous = 0;
+			bool ordered = true;
+			avlTree.ForEachInRange(30000000, 39999999, [&previous, &ordered](uint32_t gatorID, const string&) {
+				ordered = ordered && gatorID > previous && gatorID >= 30000000 && gatorID <= 39999999;
+				previous = gatorID;
+			});
+			if (!ordered) {
+				badWalks++;
+			}
+		}
+	});
+	writers.clear();
+	for (int w = 0; w < 4; w++) {
+		writers.push_back(thread([&avlTree, w] {
+			for (int round = 0; round < 4; round++) {
+				for (int i = w; i < count; i += 4) {
+					avlTree.Insert("churn", 30000000 + i);
+				}
+				for (int i = w; i < count; i += 4) {
+					avlTree.Remove(30000000 + i);
+				}
+			}
+		}));
+	}
+	for (int w = 0; w < 4; w++) {
+		writers[w].join();
+	}
+	done = true;
+	walker.join();
+	REQUIRE(badWalks == 0);
+	REQUIRE(avlTree.GetSize() == count / 2 + 1);
+}
+
+TEST_CASE("Epoch Reclamation") {
+	// An object retired while another thread is inside the epoch waits for that thread to leave
+	GatorEpochReclaimer reclaimer(1000);
+	atomic<int> stage(0);
+	thread reader([&reclaimer, &stage] {
+		reclaimer.Enter();
+		reclaimer.Enter();	// Nested, so only the outer Leave() counts
+		stage = 1;
+		while (stage != 2) {
+			this_thread::yield();
+		}
+		reclaimer.Leave();
+		stage = 3;
+		while (stage != 4) {
+			this_thread::yield();
+		}
+		reclaimer.Leave();
+		stage = 5;
+	});
+	while (stage != 1) {
+		this_thread::yield();
+	}
+	reclaimer.Retire(new string("retired"));
+	reclaimer.Reclaim();
+	REQUIRE(reclaimer.GetStats().freed == 0);
+	stage = 2;
+	while (stage != 3) {
+		this_thread::yield();
+	}
+	reclaimer.Reclaim();
+	REQUIRE(reclaimer.GetStats().freed == 0);
+	stage = 4;
+	reader.join();
+	{
+		GatorEpochReclaimer::Guard guard(reclaimer);	// The calling thread's own epoch is newer than the retired object
+		reclaimer.Reclaim();
+	}
+	GatorEpochReclaimer::EpochStats stats = reclaimer.GetStats();
+	REQUIRE(stats.freed == 1);
+	REQUIRE(stats.pending == 0);
+	REQUIRE(stats.maxPending == 1);
+	REQUIRE(stats.maxLatency >= stats.averageLatency);
+
+	// Objects retired inside the epoch are kept until a later Reclaim(), and batches free themselves
+	{
+		GatorEpochReclaimer::Guard guard(reclaimer);
+		reclaimer.Retire(new string("retired"));
+		reclaimer.Reclaim();
+		REQUIRE(reclaimer.GetStats().pending == 1);
+	}
+	for (int i = 0; i < 1999; i++) {
+		reclaimer.Retire(new int(i));
+	}
+	REQUIRE(reclaimer.GetStats().pending < 1000);
+
+	// Removals from a concurrent tree are freed while other threads keep searching
+	ConcurrentGatorAVL avlTree;
+	atomic<bool> done(false);
+	thread searcher([&avlTree, &done] {
+		GatorAVL::GatorRecord record;
+		for (unsigned int i = 0; !done; i++) {
+			avlTree.Search(30000000 + i * 7919 % 10000, record);
+		}
+	});
+	for (int round = 0; round < 5; round++) {
+		for (int i = 0; i < 10000; i++) {
+			avlTree.Insert("testname", 30000000 + i);
+		}
+		for (int i = 0; i < 10000; i++) {
+			avlTree.Remove(30000000 + i);
+		}
+	}
+	done = true;
+	searcher.join();
+	REQUIRE(avlTree.GetSize() == 0);
+	stats = avlTree.GetReclaimStats();
+	REQUIRE(stats.freed + stats.pending == 5 * 2 * 10000);	// Each removal retires its node and its name
+	REQUIRE(stats.freed > 0);
+	for (int i = 0; i < 128; i++) {		// With the searcher gone, the next batch frees everything retired before it
+		avlTree.Insert("testname", 30000000 + i);
+		avlTree.Remove(30000000 + i);
+	}
+	stats = avlTree.GetReclaimStats();
+	REQUIRE(stats.pending < 2 * 256);	// The batch retired inside the remover's own epoch waits for the next one
+	REQUIRE(stats.maxPending >= stats.pending);
+}
\ No newline at end of file
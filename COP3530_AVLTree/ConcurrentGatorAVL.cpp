@@ -0,0 +1,642 @@
+#include "ConcurrentGatorAVL.h"
+
+// Version flags -- a node that is being rotated has the shrinking flag set until the rotation is done, which then bumps the count
+const unsigned long unlinked = 1;	// The whole version once a node is out of the tree
+const unsigned long shrinking = 2;
+const unsigned long shrinkCount = 4;
+
+// Results of NodeCondition() besides a new height
+const int unlinkRequired = -1;
+const int rebalanceRequired = -2;
+const int nothingRequired = -3;
+
+ConcurrentGatorAVL::ConcurrentNode::ConcurrentNode(uint32_t gatorID, const string* name, ConcurrentNode* parent) : gatorID(gatorID) {
+	this->name = name;
+	height = 1;
+	version = 0;
+	this->parent = parent;
+	left = nullptr;
+	right = nullptr;
+	locked = false;
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::ConcurrentNode::Child(bool right) {
+	return right ? this->right.load() : left.load();
+}
+
+void ConcurrentGatorAVL::ConcurrentNode::SetChild(bool right, ConcurrentNode* child) {
+	if (right) {
+		this->right = child;
+	}
+	else {
+		left = child;
+	}
+}
+
+void ConcurrentGatorAVL::ConcurrentNode::lock() {
+	while (locked.exchange(true, memory_order_acquire)) {
+		this_thread::yield();
+	}
+}
+
+void ConcurrentGatorAVL::ConcurrentNode::unlock() {
+	locked.store(false, memory_order_release);
+}
+
+ConcurrentGatorAVL::ConcurrentGatorAVL() : rootHolder(0, nullptr, nullptr) {
+	size = 0;
+}
+
+ConcurrentGatorAVL::~ConcurrentGatorAVL() {
+	ClearTree(rootHolder.right);	// The reclaimer frees what was retired
+}
+
+bool ValidConcurrentName(const string& name) {	// Names may only contain letters and spaces, as in GatorAVL
+	for (int i = 0; i < name.length(); i++) {
+		if (!isalpha(name[i]) && name[i] != ' ') {
+			return false;
+		}
+	}
+	return true;
+}
+
+GatorAVL::GatorStatus ConcurrentGatorAVL::Insert(const string& name, uint32_t gatorID) {
+	if (gatorID > 99999999 || !ValidConcurrentName(name)) {		// gatorIDs have 8 digits at most
+		return GatorAVL::GatorStatus::Invalid;
+	}
+	GatorAVL::GatorStatus status;
+	GatorEpochReclaimer::Guard guard(reclaimer);
+	while (!AttemptInsert(name, gatorID, &rootHolder, true, 0, status)) {}	// The sentinel is never rotated, so this only loops if its own version changes -- it never does
+	return status;
+}
+
+GatorAVL::GatorStatus ConcurrentGatorAVL::Remove(uint32_t gatorID) {
+	GatorAVL::GatorStatus status;
+	GatorEpochReclaimer::Guard guard(reclaimer);
+	while (!AttemptRemove(gatorID, &rootHolder, true, 0, status)) {}
+	return status;
+}
+
+bool ConcurrentGatorAVL::Search(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	bool found;
+	GatorEpochReclaimer::Guard guard(reclaimer);
+	while (!AttemptSearch(gatorID, &rootHolder, true, 0, record, found)) {}
+	return found;
+}
+
+int ConcurrentGatorAVL::GetSize() {
+	return size;
+}
+
+int ConcurrentGatorAVL::GetLevelCount() {
+	return HeightOf(rootHolder.right);
+}
+
+GatorEpochReclaimer::EpochStats ConcurrentGatorAVL::GetReclaimStats() {
+	return reclaimer.GetStats();
+}
+
+void ConcurrentGatorAVL::PrintReclaimStats() {
+	reclaimer.PrintStats();
+}
+
+bool ConcurrentGatorAVL::AttemptSearch(uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorRecord& record, bool& found) {
+	while (true) {
+		ConcurrentNode* child = node->Child(right);
+		if (node->version != nodeVersion) {		// Checked after reading the link, so the link is known to be one node really had while the gatorID belonged below it
+			return false;
+		}
+		if (!child) {
+			found = false;
+			return true;
+		}
+		if (child->gatorID == gatorID) {
+			const string* name = child->name;
+			found = name != nullptr;
+			if (found) {
+				record.name = *name;
+				record.gatorID = gatorID;
+			}
+			return true;
+		}
+		unsigned long childVersion = child->version;
+		if (childVersion & shrinking) {
+			WaitForShrink(child, childVersion);
+		}
+		else if (childVersion != unlinked && child == node->Child(right)) {
+			if (node->version != nodeVersion) {
+				return false;
+			}
+			if (AttemptSearch(gatorID, child, gatorID > child->gatorID, childVersion, record, found)) {
+				return true;
+			}
+		}
+		// Otherwise the child moved or was rotated -- read the link again
+	}
+}
+
+bool ConcurrentGatorAVL::AttemptInsert(const string& name, uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status) {
+	while (true) {
+		ConcurrentNode* child = node->Child(right);
+		if (node->version != nodeVersion) {
+			return false;
+		}
+		if (!child) {
+			if (AttemptLink(name, gatorID, node, right, nodeVersion, status)) {
+				return true;
+			}
+		}
+		else if (child->gatorID == gatorID) {
+			if (AttemptRevive(name, child, status)) {
+				return true;
+			}
+		}
+		else {
+			unsigned long childVersion = child->version;
+			if (childVersion & shrinking) {
+				WaitForShrink(child, childVersion);
+			}
+			else if (childVersion != unlinked && child == node->Child(right)) {
+				if (node->version != nodeVersion) {
+					return false;
+				}
+				if (AttemptInsert(name, gatorID, child, gatorID > child->gatorID, childVersion, status)) {
+					return true;
+				}
+			}
+		}
+	}
+}
+
+bool ConcurrentGatorAVL::AttemptLink(const string& name, uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status) {
+	{
+		lock_guard<ConcurrentNode> guard(*node);
+		if (node->version != nodeVersion || node->Child(right)) {
+			return false;
+		}
+		node->SetChild(right, new ConcurrentNode(gatorID, new string(name), node));
+	}
+	size++;
+	status = GatorAVL::GatorStatus::Successful;
+	FixHeightAndRebalance(node);
+	return true;
+}
+
+bool ConcurrentGatorAVL::AttemptRevive(const string& name, ConcurrentNode* node, GatorAVL::GatorStatus& status) {
+	lock_guard<ConcurrentNode> guard(*node);
+	if (node->version == unlinked) {
+		return false;
+	}
+	if (node->name) {
+		status = GatorAVL::GatorStatus::Duplicate;
+	}
+	else {
+		node->name = new string(name);
+		size++;
+		status = GatorAVL::GatorStatus::Successful;
+	}
+	return true;
+}
+
+bool ConcurrentGatorAVL::AttemptRemove(uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status) {
+	while (true) {
+		ConcurrentNode* child = node->Child(right);
+		if (node->version != nodeVersion) {
+			return false;
+		}
+		if (!child) {
+			status = GatorAVL::GatorStatus::NotFound;
+			return true;
+		}
+		if (child->gatorID == gatorID) {
+			if (AttemptRemoveNode(node, child, status)) {
+				return true;
+			}
+		}
+		else {
+			unsigned long childVersion = child->version;
+			if (childVersion & shrinking) {
+				WaitForShrink(child, childVersion);
+			}
+			else if (childVersion != unlinked && child == node->Child(right)) {
+				if (node->version != nodeVersion) {
+					return false;
+				}
+				if (AttemptRemove(gatorID, child, gatorID > child->gatorID, childVersion, status)) {
+					return true;
+				}
+			}
+		}
+	}
+}
+
+bool ConcurrentGatorAVL::AttemptRemoveNode(ConcurrentNode* parent, ConcurrentNode* node, GatorAVL::GatorStatus& status) {
+	if (!node->name) {
+		status = GatorAVL::GatorStatus::NotFound;
+		return true;
+	}
+	const string* name;
+	if (node->left && node->right) {	// Keep the node in place as a routing node
+		lock_guard<ConcurrentNode> guard(*node);
+		if (node->version == unlinked || !node->left || !node->right) {
+			return false;
+		}
+		name = node->name;
+		if (!name) {
+			status = GatorAVL::GatorStatus::NotFound;
+			return true;
+		}
+		node->name = nullptr;
+	}
+	else {
+		{
+			lock_guard<ConcurrentNode> parentGuard(*parent);
+			if (parent->version == unlinked || node->parent != parent) {
+				return false;
+			}
+			lock_guard<ConcurrentNode> guard(*node);
+			if (node->version == unlinked) {
+				return false;
+			}
+			name = node->name;
+			if (!name) {
+				status = GatorAVL::GatorStatus::NotFound;
+				return true;
+			}
+			ConcurrentNode* left = node->left;
+			ConcurrentNode* right = node->right;
+			if (left && right) {
+				return false;
+			}
+			ConcurrentNode* splice = left ? left : right;
+			if (parent->left == node) {
+				parent->left = splice;
+			}
+			else {
+				parent->right = splice;
+			}
+			if (splice) {
+				splice->parent = parent;
+			}
+			node->version = unlinked;
+			node->name = nullptr;
+			reclaimer.Retire(node);
+		}
+		FixHeightAndRebalance(parent);
+	}
+	reclaimer.Retire(name);
+	size--;
+	status = GatorAVL::GatorStatus::Successful;
+	return true;
+}
+
+void ConcurrentGatorAVL::WaitForShrink(ConcurrentNode* node, unsigned long version) {
+	while (node->version == version) {
+		this_thread::yield();
+	}
+}
+
+void ConcurrentGatorAVL::FixHeightAndRebalance(ConcurrentNode* node) {
+	while (node && node->parent) {	// The sentinel has no parent
+		int condition = NodeCondition(node);
+		if (condition == nothingRequired || node->version == unlinked) {
+			return;
+		}
+		if (condition != unlinkRequired && condition != rebalanceRequired) {	// Only the height is wrong, which needs no other lock
+			lock_guard<ConcurrentNode> guard(*node);
+			node = FixHeightLocked(node);
+		}
+		else {
+			ConcurrentNode* parent = node->parent;
+			lock_guard<ConcurrentNode> parentGuard(*parent);
+			if (parent->version != unlinked && node->parent == parent) {
+				lock_guard<ConcurrentNode> guard(*node);
+				if (node->version != unlinked) {	// Another thread may have unlinked it before parent was locked
+					node = RebalanceLocked(parent, node);
+				}
+			}
+			// Otherwise node moved -- look at it again
+		}
+	}
+}
+
+int ConcurrentGatorAVL::HeightOf(ConcurrentNode* node) {
+	return node ? node->height.load() : 0;
+}
+
+int ConcurrentGatorAVL::NodeCondition(ConcurrentNode* node) {
+	ConcurrentNode* left = node->left;
+	ConcurrentNode* right = node->right;
+	if ((!left || !right) && !node->name) {
+		return unlinkRequired;
+	}
+	int leftHeight = HeightOf(left);
+	int rightHeight = HeightOf(right);
+	int newHeight = 1 + max(leftHeight, rightHeight);
+	int balance = leftHeight - rightHeight;
+	if (balance < -1 || balance > 1) {
+		return rebalanceRequired;
+	}
+	return node->height != newHeight ? newHeight : nothingRequired;
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::FixHeightLocked(ConcurrentNode* node) {
+	int condition = NodeCondition(node);
+	if (condition == rebalanceRequired || condition == unlinkRequired) {	// Go back to the caller's loop, which takes the parent's lock too
+		return node;
+	}
+	if (condition == nothingRequired) {
+		return nullptr;
+	}
+	node->height = condition;
+	return node->parent;
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RebalanceLocked(ConcurrentNode* parent, ConcurrentNode* node) {
+	ConcurrentNode* left = node->left;
+	ConcurrentNode* right = node->right;
+	if ((!left || !right) && !node->name) {
+		if (UnlinkLocked(parent, node)) {
+			return FixHeightLocked(parent);
+		}
+		return node;
+	}
+	int leftHeight = HeightOf(left);
+	int rightHeight = HeightOf(right);
+	int newHeight = 1 + max(leftHeight, rightHeight);
+	int balance = leftHeight - rightHeight;
+	if (balance > 1) {
+		return RebalanceToRightLocked(parent, node, left, rightHeight);
+	}
+	else if (balance < -1) {
+		return RebalanceToLeftLocked(parent, node, right, leftHeight);
+	}
+	else if (node->height != newHeight) {
+		node->height = newHeight;
+		return FixHeightLocked(parent);
+	}
+	return nullptr;
+}
+
+bool ConcurrentGatorAVL::UnlinkLocked(ConcurrentNode* parent, ConcurrentNode* node) {
+	ConcurrentNode* parentLeft = parent->left;
+	ConcurrentNode* parentRight = parent->right;
+	if (parentLeft != node && parentRight != node) {
+		return false;
+	}
+	ConcurrentNode* left = node->left;
+	ConcurrentNode* right = node->right;
+	if ((left && right) || node->name) {
+		return false;
+	}
+	ConcurrentNode* splice = left ? left : right;
+	if (parentLeft == node) {
+		parent->left = splice;
+	}
+	else {
+		parent->right = splice;
+	}
+	if (splice) {
+		splice->parent = parent;
+	}
+	node->version = unlinked;
+	reclaimer.Retire(node);
+	return true;
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RebalanceToRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight) {
+	lock_guard<ConcurrentNode> leftGuard(*left);
+	if (left->height - rightHeight <= 1) {	// Changed since it was read -- start over
+		return node;
+	}
+	ConcurrentNode* leftRight = left->right;
+	int leftLeftHeight = HeightOf(left->left);
+	int leftRightHeight = HeightOf(leftRight);
+	if (leftLeftHeight >= leftRightHeight) {
+		return RotateRightLocked(parent, node, left, rightHeight, leftLeftHeight, leftRight, leftRightHeight);
+	}
+	{
+		lock_guard<ConcurrentNode> leftRightGuard(*leftRight);	// Not null, since it is taller than its sibling
+		leftRightHeight = leftRight->height;
+		if (leftLeftHeight >= leftRightHeight) {
+			return RotateRightLocked(parent, node, left, rightHeight, leftLeftHeight, leftRight, leftRightHeight);
+		}
+		int leftRightLeftHeight = HeightOf(leftRight->left);
+		int balance = leftLeftHeight - leftRightLeftHeight;
+		if (balance >= -1 && balance <= 1 && !((leftLeftHeight == 0 || leftRightLeftHeight == 0) && !left->name)) {
+			return RotateRightOverLeftLocked(parent, node, left, rightHeight, leftLeftHeight, leftRight, leftRightLeftHeight);
+		}
+	}
+	return RebalanceToLeftLocked(node, left, leftRight, leftLeftHeight);	// The double rotation would leave left unbalanced, so rotate it first
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RebalanceToLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight) {
+	lock_guard<ConcurrentNode> rightGuard(*right);
+	if (right->height - leftHeight <= 1) {
+		return node;
+	}
+	ConcurrentNode* rightLeft = right->left;
+	int rightRightHeight = HeightOf(right->right);
+	int rightLeftHeight = HeightOf(rightLeft);
+	if (rightRightHeight >= rightLeftHeight) {
+		return RotateLeftLocked(parent, node, right, leftHeight, rightRightHeight, rightLeft, rightLeftHeight);
+	}
+	{
+		lock_guard<ConcurrentNode> rightLeftGuard(*rightLeft);
+		rightLeftHeight = rightLeft->height;
+		if (rightRightHeight >= rightLeftHeight) {
+			return RotateLeftLocked(parent, node, right, leftHeight, rightRightHeight, rightLeft, rightLeftHeight);
+		}
+		int rightLeftRightHeight = HeightOf(rightLeft->right);
+		int balance = rightRightHeight - rightLeftRightHeight;
+		if (balance >= -1 && balance <= 1 && !((rightRightHeight == 0 || rightLeftRightHeight == 0) && !right->name)) {
+			return RotateLeftOverRightLocked(parent, node, right, leftHeight, rightRightHeight, rightLeft, rightLeftRightHeight);
+		}
+	}
+	return RebalanceToRightLocked(node, right, rightLeft, rightRightHeight);
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RotateRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight, int leftLeftHeight, ConcurrentNode* leftRight, int leftRightHeight) {
+	unsigned long nodeVersion = node->version;
+	ConcurrentNode* parentLeft = parent->left;
+	node->version = nodeVersion | shrinking;	// Keys in left's subtree are leaving node's subtree
+	node->left = leftRight;
+	if (leftRight) {
+		leftRight->parent = node;
+	}
+	left->right = node;
+	node->parent = left;
+	if (parentLeft == node) {
+		parent->left = left;
+	}
+	else {
+		parent->right = left;
+	}
+	left->parent = parent;
+	int newNodeHeight = 1 + max(leftRightHeight, rightHeight);
+	node->height = newNodeHeight;
+	left->height = 1 + max(leftLeftHeight, newNodeHeight);
+	node->version = nodeVersion + shrinkCount;
+	// Report the lowest node that is still out of shape, or carry on upward
+	int nodeBalance = leftRightHeight - rightHeight;
+	if (nodeBalance < -1 || nodeBalance > 1) {
+		return node;
+	}
+	if ((!leftRight || rightHeight == 0) && !node->name) {
+		return node;
+	}
+	int leftBalance = leftLeftHeight - newNodeHeight;
+	if (leftBalance < -1 || leftBalance > 1) {
+		return left;
+	}
+	if (leftLeftHeight == 0 && !left->name) {
+		return left;
+	}
+	return FixHeightLocked(parent);
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RotateLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight, int rightRightHeight, ConcurrentNode* rightLeft, int rightLeftHeight) {
+	unsigned long nodeVersion = node->version;
+	ConcurrentNode* parentLeft = parent->left;
+	node->version = nodeVersion | shrinking;
+	node->right = rightLeft;
+	if (rightLeft) {
+		rightLeft->parent = node;
+	}
+	right->left = node;
+	node->parent = right;
+	if (parentLeft == node) {
+		parent->left = right;
+	}
+	else {
+		parent->right = right;
+	}
+	right->parent = parent;
+	int newNodeHeight = 1 + max(rightLeftHeight, leftHeight);
+	node->height = newNodeHeight;
+	right->height = 1 + max(rightRightHeight, newNodeHeight);
+	node->version = nodeVersion + shrinkCount;
+	int nodeBalance = rightLeftHeight - leftHeight;
+	if (nodeBalance < -1 || nodeBalance > 1) {
+		return node;
+	}
+	if ((!rightLeft || leftHeight == 0) && !node->name) {
+		return node;
+	}
+	int rightBalance = rightRightHeight - newNodeHeight;
+	if (rightBalance < -1 || rightBalance > 1) {
+		return right;
+	}
+	if (rightRightHeight == 0 && !right->name) {
+		return right;
+	}
+	return FixHeightLocked(parent);
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RotateRightOverLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight, int leftLeftHeight, ConcurrentNode* leftRight, int leftRightLeftHeight) {
+	unsigned long nodeVersion = node->version;
+	unsigned long leftVersion = left->version;
+	ConcurrentNode* parentLeft = parent->left;
+	ConcurrentNode* leftRightLeft = leftRight->left;
+	ConcurrentNode* leftRightRight = leftRight->right;
+	int leftRightRightHeight = HeightOf(leftRightRight);
+	node->version = nodeVersion | shrinking;
+	left->version = leftVersion | shrinking;
+	node->left = leftRightRight;
+	if (leftRightRight) {
+		leftRightRight->parent = node;
+	}
+	left->right = leftRightLeft;
+	if (leftRightLeft) {
+		leftRightLeft->parent = left;
+	}
+	leftRight->left = left;
+	left->parent = leftRight;
+	leftRight->right = node;
+	node->parent = leftRight;
+	if (parentLeft == node) {
+		parent->left = leftRight;
+	}
+	else {
+		parent->right = leftRight;
+	}
+	leftRight->parent = parent;
+	int newNodeHeight = 1 + max(leftRightRightHeight, rightHeight);
+	node->height = newNodeHeight;
+	int newLeftHeight = 1 + max(leftLeftHeight, leftRightLeftHeight);
+	left->height = newLeftHeight;
+	leftRight->height = 1 + max(newLeftHeight, newNodeHeight);
+	node->version = nodeVersion + shrinkCount;
+	left->version = leftVersion + shrinkCount;
+	int nodeBalance = leftRightRightHeight - rightHeight;
+	if (nodeBalance < -1 || nodeBalance > 1) {
+		return node;
+	}
+	if ((!leftRightRight || rightHeight == 0) && !node->name) {
+		return node;
+	}
+	int leftRightBalance = newLeftHeight - newNodeHeight;
+	if (leftRightBalance < -1 || leftRightBalance > 1) {
+		return leftRight;
+	}
+	return FixHeightLocked(parent);
+}
+
+ConcurrentGatorAVL::ConcurrentNode* ConcurrentGatorAVL::RotateLeftOverRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight, int rightRightHeight, ConcurrentNode* rightLeft, int rightLeftRightHeight) {
+	unsigned long nodeVersion = node->version;
+	unsigned long rightVersion = right->version;
+	ConcurrentNode* parentLeft = parent->left;
+	ConcurrentNode* rightLeftLeft = rightLeft->left;
+	ConcurrentNode* rightLeftRight = rightLeft->right;
+	int rightLeftLeftHeight = HeightOf(rightLeftLeft);
+	node->version = nodeVersion | shrinking;
+	right->version = rightVersion | shrinking;
+	node->right = rightLeftLeft;
+	if (rightLeftLeft) {
+		rightLeftLeft->parent = node;
+	}
+	right->left = rightLeftRight;
+	if (rightLeftRight) {
+		rightLeftRight->parent = right;
+	}
+	rightLeft->right = right;
+	right->parent = rightLeft;
+	rightLeft->left = node;
+	node->parent = rightLeft;
+	if (parentLeft == node) {
+		parent->left = rightLeft;
+	}
+	else {
+		parent->right = rightLeft;
+	}
+	rightLeft->parent = parent;
+	int newNodeHeight = 1 + max(rightLeftLeftHeight, leftHeight);
+	node->height = newNodeHeight;
+	int newRightHeight = 1 + max(rightRightHeight, rightLeftRightHeight);
+	right->height = newRightHeight;
+	rightLeft->height = 1 + max(newRightHeight, newNodeHeight);
+	node->version = nodeVersion + shrinkCount;
+	right->version = rightVersion + shrinkCount;
+	int nodeBalance = rightLeftLeftHeight - leftHeight;
+	if (nodeBalance < -1 || nodeBalance > 1) {
+		return node;
+	}
+	if ((!rightLeftLeft || leftHeight == 0) && !node->name) {
+		return node;
+	}
+	int rightLeftBalance = newRightHeight - newNodeHeight;
+	if (rightLeftBalance < -1 || rightLeftBalance > 1) {
+		return rightLeft;
+	}
+	return FixHeightLocked(parent);
+}
+
+void ConcurrentGatorAVL::ClearTree(ConcurrentNode* node) {
+	if (!node) {
+		return;
+	}
+	ClearTree(node->left);
+	ClearTree(node->right);
+	delete node->name.load();
+	delete node;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GatorAVL.h"
+#include "GatorEpochReclaimer.h"
+
+using namespace std;
+
+// AVL tree that many threads can update at once, after Bronson, Casper, Chafi and Olukotun, "A Practical Concurrent Binary Search Tree" (PPoPP 2010)
+// Searches take no locks: they move down hand over hand, checking a node's version after reading its child link, and retry when a rotation moved keys away
+// Updates lock only the nodes they change, and balance is relaxed -- each update repairs heights and rotates on its way back up, one node at a time
+// Removing a node with two children only clears its name, leaving a routing node that is unlinked once it has at most one child
+class ConcurrentGatorAVL {
+	struct ConcurrentNode {
+		const uint32_t gatorID;
+		atomic<const string*> name;		// Null in a routing node -- a name is never changed in place, so a search can copy it without a lock
+		atomic<int> height;
+		atomic<unsigned long> version;	// Marks rotations that move keys out of this node's subtree, so a search below it can tell it went the wrong way
+		atomic<ConcurrentNode*> parent;
+		atomic<ConcurrentNode*> left;
+		atomic<ConcurrentNode*> right;
+		atomic<bool> locked;
+
+		ConcurrentNode(uint32_t gatorID, const string* name, ConcurrentNode* parent);
+		ConcurrentNode* Child(bool right);
+		void SetChild(bool right, ConcurrentNode* child);
+		// A spin lock is enough, since it is only held for a few loads and stores (named as in the standard library, so lock_guard works with it)
+		void lock();
+		void unlock();
+	};
+
+private:
+	ConcurrentNode rootHolder;	// Sentinel whose right child is the root, so the root can be replaced like any other child
+	atomic<int> size;
+	GatorEpochReclaimer reclaimer;	// Nodes and names taken out of the tree are retired here, since a search may still be reading them
+
+	// Each Attempt function works below one node whose version the caller read, and returns false to make the caller retry if that version changed
+	bool AttemptSearch(uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorRecord& record, bool& found);
+	bool AttemptInsert(const string& name, uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status);
+	bool AttemptLink(const string& name, uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status);	// Hang a new node at an empty link
+	bool AttemptRevive(const string& name, ConcurrentNode* node, GatorAVL::GatorStatus& status);		// Give a routing node a name again
+	bool AttemptRemove(uint32_t gatorID, ConcurrentNode* node, bool right, unsigned long nodeVersion, GatorAVL::GatorStatus& status);
+	bool AttemptRemoveNode(ConcurrentNode* parent, ConcurrentNode* node, GatorAVL::GatorStatus& status);
+	static void WaitForShrink(ConcurrentNode* node, unsigned long version);		// Wait for the rotation that set a node's shrinking flag to finish
+
+	// Rebalancing -- the Locked functions expect the nodes they are given (all but the last child) to be locked already,
+	// and return the next node that needs repairs, or null once the tree above is settled:
+	void FixHeightAndRebalance(ConcurrentNode* node);
+	static int HeightOf(ConcurrentNode* node);
+	static int NodeCondition(ConcurrentNode* node);		// The height a node should have, or the kind of repair it needs
+	ConcurrentNode* FixHeightLocked(ConcurrentNode* node);
+	ConcurrentNode* RebalanceLocked(ConcurrentNode* parent, ConcurrentNode* node);
+	bool UnlinkLocked(ConcurrentNode* parent, ConcurrentNode* node);		// Splice out a routing node with at most one child
+	ConcurrentNode* RebalanceToRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight);
+	ConcurrentNode* RebalanceToLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight);
+	ConcurrentNode* RotateRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight, int leftLeftHeight, ConcurrentNode* leftRight, int leftRightHeight);
+	ConcurrentNode* RotateLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight, int rightRightHeight, ConcurrentNode* rightLeft, int rightLeftHeight);
+	ConcurrentNode* RotateRightOverLeftLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left, int rightHeight, int leftLeftHeight, ConcurrentNode* leftRight, int leftRightLeftHeight);
+	ConcurrentNode* RotateLeftOverRightLocked(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right, int leftHeight, int rightRightHeight, ConcurrentNode* rightLeft, int rightLeftRightHeight);
+
+	void ClearTree(ConcurrentNode* node);
+
+	template <typename Callback>
+	static void RecursiveRange(ConcurrentNode* node, uint64_t& next, uint32_t high, Callback& callback);	// next is the smallest gatorID not passed to callback yet
+
+public:
+	ConcurrentGatorAVL();
+	~ConcurrentGatorAVL();
+	ConcurrentGatorAVL(const ConcurrentGatorAVL&) = delete;
+	ConcurrentGatorAVL& operator=(const ConcurrentGatorAVL&) = delete;
+
+	// Safe to call from any number of threads at once:
+	GatorAVL::GatorStatus Insert(const string& name, uint32_t gatorID);
+	GatorAVL::GatorStatus Remove(uint32_t gatorID);
+	bool Search(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	int GetSize();
+	// Safe during updates, but only exact while none are running -- a rotation during the walk can hide records from it:
+	template <typename Callback>
+	void ForEachInRange(uint32_t low, uint32_t high, Callback callback) {	// Call callback(gatorID, name) for each record in [low, high] in ascending order, each at most once
+		GatorEpochReclaimer::Guard guard(reclaimer);
+		uint64_t next = low;	// 64 bits, so it can step past the largest gatorID
+		RecursiveRange(rootHolder.right, next, high, callback);
+	}
+
+	// Only valid while no updates are running:
+	int GetLevelCount();
+
+	GatorEpochReclaimer::EpochStats GetReclaimStats();
+	void PrintReclaimStats();	// Print the length of the retire lists and how long retired nodes waited to be freed
+};
+
+template <typename Callback>
+void ConcurrentGatorAVL::RecursiveRange(ConcurrentNode* node, uint64_t& next, uint32_t high, Callback& callback) {
+	if (!node) {
+		return;
+	}
+	if (node->gatorID > next) {
+		RecursiveRange(node->left, next, high, callback);
+	}
+	// A rotation can carry a node the walk already passed into a subtree it has yet to visit, so keys below next are skipped
+	// rather than passed on again, and every subtree is pruned against next instead of the original low end
+	const string* name = node->name;
+	if (name && node->gatorID >= next && node->gatorID <= high) {	// Routing nodes are skipped
+		callback(node->gatorID, *name);
+		next = (uint64_t)node->gatorID + 1;
+	}
+	if (node->gatorID < high) {
+		RecursiveRange(node->right, next, high, callback);
+	}
+}
\ No newline at end of file
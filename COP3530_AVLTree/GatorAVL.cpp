@@ -1,10 +1,12 @@
 #include "GatorAVL.h"
 
 // GatorNode function definitions:
-GatorAVL::GatorNode::GatorNode(string name, unsigned long gatorID, int height, GatorNode* left, GatorNode* right) {
-	this->name = name;
+GatorAVL::GatorNode::GatorNode(uint32_t nameIndex, uint32_t gatorID, int height, GatorNode* left, GatorNode* right) {
+	this->nameIndex = nameIndex;
 	this->gatorID = gatorID;
 	this->height = height;
+	this->subtreeSize = 1;
+	this->references = 1;
 	this->left = left;
 	this->right = right;
 }
@@ -46,13 +48,159 @@ int GatorAVL::GatorNode::FindBF() {
 }
 
 
+int GatorAVL::GatorNode::FindSubtreeSize() {
+	int sizeLeft = 0;
+	int sizeRight = 0;
+	if (left) {
+		sizeLeft = left->subtreeSize;
+	}
+	if (right) {
+		sizeRight = right->subtreeSize;
+	}
+	return 1 + sizeLeft + sizeRight;
+}
+
+
 // GatorAVL private member function definitions:
+GatorAVL::GatorNode* GatorAVL::NewNode(uint32_t nameIndex, uint32_t gatorID) {
+	if (nameIndexEnabled) {
+		if (nameIndex >= this->nameIndex.size()) {
+			this->nameIndex.resize(nameIndex + 1);
+		}
+		this->nameIndex[nameIndex].insert(gatorID);
+	}
+	if (pool) {
+		return pool->Allocate(nameIndex, gatorID);
+	}
+	return new GatorNode(nameIndex, gatorID);
+}
+
+void GatorAVL::DeleteNode(GatorNode* node) {
+	if (nameIndexEnabled) {
+		nameIndex[node->nameIndex].erase(node->gatorID);
+	}
+	FreeNode(node, pool.get(), *names);
+}
+
+void GatorAVL::FreeNode(GatorNode* node, GatorNodePool<GatorNode>* pool, GatorNameTable& names) {
+	names.Release(node->nameIndex);
+	if (pool) {
+		pool->Free(node);
+	}
+	else {
+		delete node;
+	}
+}
+
+void GatorAVL::Share(GatorNode* node) {
+	if (node && node->references < UINT16_MAX) {
+		node->references++;
+	}
+}
+
+GatorAVL::GatorNode* GatorAVL::Exclusive(GatorNode* node) {
+	if (!node || node->references == 1) {
+		return node;
+	}
+	names->Retain(node->nameIndex);
+	GatorNode* copy = NewNode(node->nameIndex, node->gatorID);
+	copy->height = node->height;
+	copy->subtreeSize = node->subtreeSize;
+	copy->left = node->left;
+	copy->right = node->right;
+	Share(copy->left);	// The children now have the copy as a parent as well
+	Share(copy->right);
+	if (node->references < UINT16_MAX) {
+		node->references--;		// The caller's reference moves to the copy
+	}
+	return copy;
+}
+
+GatorAVL::GatorNode** GatorAVL::UnsharePath(GatorNode** link) {	// Path copying: only the nodes from the first shared one down are copied
+	if (versions->live == 0) {
+		return link;
+	}
+	for (int i = 0; i <= path.size(); i++) {
+		GatorNode** current = i < path.size() ? path[i] : link;
+		GatorNode* node = *current;
+		if (!node || node->references == 1) {
+			continue;
+		}
+		GatorNode* copy = Exclusive(node);
+		*current = copy;
+		if (i < path.size()) {	// The next link on the path lives in the node that was just replaced
+			GatorNode**& next = i + 1 < path.size() ? path[i + 1] : link;
+			if (next == &node->left) {
+				next = &copy->left;
+			}
+			else {
+				next = &copy->right;
+			}
+		}
+	}
+	return link;
+}
+
+void GatorAVL::ReleaseNodes(GatorNode* node, GatorNodePool<GatorNode>* pool, GatorNameTable& names) {
+	if (!node || node->references == UINT16_MAX) {
+		return;
+	}
+	node->references--;
+	if (node->references > 0) {		// Still part of the tree or of another version
+		return;
+	}
+	ReleaseNodes(node->left, pool, names);
+	ReleaseNodes(node->right, pool, names);
+	FreeNode(node, pool, names);
+}
+
+void GatorAVL::ReclaimVersions() {
+	if (versions->live == 0) {	// Released versions are counted until they are reclaimed, so there is nothing waiting
+		return;
+	}
+	vector<GatorNode*> released;
+	{
+		lock_guard<mutex> guard(versions->lock);
+		if (versions->released.empty()) {
+			return;
+		}
+		released.swap(versions->released);
+		versions->live -= released.size();
+	}
+	for (int i = 0; i < released.size(); i++) {
+		ReleaseNodes(released[i], pool.get(), *names);
+	}
+}
+
+void GatorAVL::BeginUpdate() {
+	version++;
+	ReclaimVersions();
+}
+
+void GatorAVL::DetachVersions() {
+	lock_guard<mutex> guard(versions->lock);	// Held while releasing, since versions dropped on other threads release themselves once trees is 0
+	for (int i = 0; i < versions->released.size(); i++) {
+		ReleaseNodes(versions->released[i], pool.get(), *names);
+	}
+	versions->live -= versions->released.size();
+	versions->released.clear();
+	versions->trees--;
+}
+
+void GatorAVL::AttachVersions(shared_ptr<VersionQueue> queue) {
+	DetachVersions();
+	versions = queue;
+	lock_guard<mutex> guard(versions->lock);
+	versions->trees++;
+}
+
 GatorAVL::GatorNode* GatorAVL::RotateLeft(GatorNode* root) {	// Referenced code from Lecture 4a
 	GatorNode* grandChild = root->right->left;
 	GatorNode* newRoot = root->right;
 	newRoot->left = root;
 	root->right = grandChild;
 	root->height = root->FindHeight();	// Recalculate the height of the original root node
+	root->subtreeSize = root->FindSubtreeSize();
 	return newRoot;
 }
 
@@ -62,6 +210,7 @@ GatorAVL::GatorNode* GatorAVL::RotateRight(GatorNode* root) {
 	newRoot->right = root;
 	root->left = grandChild;
 	root->height = root->FindHeight();	// Recalculate the height of the original root node
+	root->subtreeSize = root->FindSubtreeSize();
 	return newRoot;
 }
 
@@ -78,124 +227,192 @@ GatorAVL::GatorNode* GatorAVL::RotateRightLeft(GatorNode* root) {
 GatorAVL::GatorNode* GatorAVL::BalanceNode(GatorNode* node) {
 	int balanceFactor = node->FindBF();
 	if (balanceFactor < -1) {
-		if (node->right->FindBF() < 0) {	// There is a right-right imbalance at the given node
+		node->right = Exclusive(node->right);	// Rotations change the children as well as the node itself
+		if (node->right->FindBF() <= 0) {	// There is a right-right imbalance at the given node (a balanced right child also needs only one rotation)
 			return RotateLeft(node);
 		}
 		else {	// There is a right-left imbalance at the given node
+			node->right->left = Exclusive(node->right->left);
 			return RotateRightLeft(node);
 		}
 	}
 	else if (balanceFactor > 1) {
-		if (node->left->FindBF() > 0) {	// There is a left-left imbalance at the given node
+		node->left = Exclusive(node->left);
+		if (node->left->FindBF() >= 0) {	// There is a left-left imbalance at the given node
 			return RotateRight(node);
 		}
 		else {	// There is a left-right imbalance at the given node
+			node->left->right = Exclusive(node->left->right);
 			return RotateLeftRight(node);
 		}
 	}
 	return node;
 }
 
-GatorAVL::GatorNode* GatorAVL::RecursiveInsert(GatorNode* root, string name, unsigned long gatorID) {	// Referenced pseudocode from Lecture 3a
-	// Recursively insert the node at the correct location:
-	if (!root) {
-		return new GatorNode(name, gatorID);
+GatorAVL::GatorNode** GatorAVL::FindLink(uint32_t gatorID) {
+	BeginUpdate();
+	path.clear();
+	GatorNode** link = &root;
+	while (*link && (*link)->gatorID != gatorID) {
+		path.push_back(link);
+		if (gatorID < (*link)->gatorID) {
+			link = &(*link)->left;
+		}
+		else {
+			link = &(*link)->right;
+		}
 	}
-	else if (root->gatorID == gatorID) {	// Handling the case of duplicate IDs
-		throw exception();
+	return link;
+}
+
+void GatorAVL::InsertAtPath(GatorNode** link, GatorNode* node) {
+	*link = node;
+	for (int i = 0; i < path.size(); i++) {		// Every ancestor gains one node, even the ones Retrace() does not reach
+		(*path[i])->subtreeSize++;
 	}
-	else if (gatorID < root->gatorID) {
-		root->left = RecursiveInsert(root->left, name, gatorID);
+	Retrace();
+}
+
+template <typename Name>
+GatorAVL::GatorStatus GatorAVL::InsertName(Name&& name, uint32_t gatorID) {
+	if (gatorID > 99999999 || !ValidName(name)) {	// gatorIDs have 8 digits at most
+		return GatorStatus::Invalid;
 	}
-	else {
-		root->right = RecursiveInsert(root->right, name, gatorID);
+	GatorNode** link = FindLink(gatorID);
+	if (*link) {	// Handling the case of duplicate IDs
+		return GatorStatus::Duplicate;
 	}
-	// Balance the tree along the search path:
-	root = BalanceNode(root);
-	root->height = root->FindHeight();
+	link = UnsharePath(link);
+	InsertAtPath(link, NewNode(names->Intern(forward<Name>(name)), gatorID));	// The name is only interned once the insertion is known to succeed
+	size++;
+	return GatorStatus::Successful;
+}
 
-	return root;
+bool GatorAVL::IterativeRemove(uint32_t gatorID) {
+	GatorNode** link = FindLink(gatorID);
+	if (!*link) {	// Handling the case of a non-existent search parameter
+		return false;
+	}
+	RemoveAtPath(UnsharePath(link));
+	return true;
 }
 
-GatorAVL::GatorNode* GatorAVL::RecursiveRemove(GatorNode* root, unsigned long gatorID) {	// Referenced pseudocode from Lecture 3b
-	if (!root) {	// Handling the case of a non-existent search parameter
-		throw exception();
+void GatorAVL::IterativeRemoveInorder(int index) {
+	BeginUpdate();
+	path.clear();
+	GatorNode** link = &root;
+	while (true) {
+		int leftSize = 0;
+		if ((*link)->left) {
+			leftSize = (*link)->left->subtreeSize;
+		}
+		if (index == leftSize) {
+			break;
+		}
+		path.push_back(link);
+		if (index < leftSize) {	// The desired node is in the left subtree
+			link = &(*link)->left;
+		}
+		else {	// Skip the left subtree and this node
+			index -= leftSize + 1;
+			link = &(*link)->right;
+		}
 	}
-	if (gatorID < root->gatorID) {
-		root->left = RecursiveRemove(root->left, gatorID);
+	RemoveAtPath(UnsharePath(link));
+}
+
+void GatorAVL::RemoveAtPath(GatorNode** link) {
+	GatorNode* node = *link;
+	if (node->left && node->right) {	// The node has a right and left child -- swap its record with its inorder successor and remove that node instead
+		path.push_back(link);
+		GatorNode** successorLink = &node->right;
+		*successorLink = Exclusive(*successorLink);		// The successor's record and its ancestors' sizes change too
+		while ((*successorLink)->left) {
+			path.push_back(successorLink);
+			successorLink = &(*successorLink)->left;
+			*successorLink = Exclusive(*successorLink);
+		}
+		GatorNode* successor = *successorLink;
+		swap(node->gatorID, successor->gatorID);
+		swap(node->nameIndex, successor->nameIndex);
+		link = successorLink;
+		node = successor;
 	}
-	else if (gatorID > root->gatorID) {
-		root->right = RecursiveRemove(root->right, gatorID);
+	if (node->left) {	// The node now has at most one child, which takes its place
+		*link = node->left;
 	}
 	else {
-		if (!root->left && !root->right) {	// The desired node has no children
-			delete root;
-			return nullptr;
-		}
-		else if (root->left && !root->right) {	// The desired node only has a left child
-			GatorNode* temp = root->left;
-			delete root;
-			return temp;
-		}
-		else if (root->right && !root->left) {	// The desired node only has a right child
-			GatorNode* temp = root->right;
-			delete root;
-			return temp;
-		}
-		else {	// The desired node has a right and left child -- find the inorder successor
-			if (!root->right->left) {
-				GatorNode* temp = root->right;
-				temp->left = root->left;
-				delete root;
-				return temp;
-			}
-			else {
-				GatorNode* currNode = root->right;	// Used to traverse to the parent of the inorder successor
-				while (currNode->left->left) {
-					currNode = currNode->left;
-				}
-				GatorNode* temp = currNode->left;
-				currNode->left = temp->right;
-				temp->left = root->left;
-				temp->right = root->right;
-				delete root;
-				return temp;
-			}
-		}
+		*link = node->right;
+	}
+	DeleteNode(node);
+	for (int i = 0; i < path.size(); i++) {
+		(*path[i])->subtreeSize--;
 	}
-	// Balance the tree along the search path:
-	root = BalanceNode(root);
-	root->height = root->FindHeight();
+	Retrace();
+}
 
-	return root;
+void GatorAVL::Retrace() {
+	lastTouched = 0;
+	stableDepth = path.size();
+	for (int i = path.size() - 1; i >= 0; i--) {
+		GatorNode* node = *path[i];
+		int oldHeight = node->height;
+		node = BalanceNode(node);
+		node->height = node->FindHeight();
+		node->subtreeSize = node->FindSubtreeSize();
+		if (node != *path[i]) {		// A rotation moved the links below this one
+			stableDepth = i + 1;
+		}
+		*path[i] = node;
+		lastTouched++;
+		if (node->height == oldHeight) {	// Nothing above this subtree can see a difference -- after an insertion this happens by the first rotation
+			break;
+		}
+	}
 }
 
-void GatorAVL::RecursiveRemoveInorder(GatorNode* root, int& count) {
-	if (!root) {
-		return;
+GatorAVL::GatorNode** GatorAVL::FingerLink(uint32_t gatorID, pair<int64_t, int64_t>& bounds) {
+	if (fingerVersion != version) {		// The tree changed since the last finger operation -- start from the root
+		path.clear();
+		pathBounds.clear();
+		path.push_back(&root);
+		pathBounds.push_back(make_pair(-1, (int64_t)UINT32_MAX + 1));
 	}
-	else {
-		RecursiveRemoveInorder(root->left, count);
-		if (count != 0) {
-			count--;
+	while (path.size() > 1 && (gatorID <= pathBounds.back().first || gatorID >= pathBounds.back().second)) {	// Climb to the lowest subtree that can hold gatorID
+		path.pop_back();
+		pathBounds.pop_back();
+	}
+	GatorNode** link = path.back();
+	bounds = pathBounds.back();
+	path.pop_back();
+	pathBounds.pop_back();
+	while (*link && (*link)->gatorID != gatorID) {	// Continue exactly like FindLink()
+		path.push_back(link);
+		pathBounds.push_back(bounds);
+		if (gatorID < (*link)->gatorID) {
+			bounds.second = (*link)->gatorID;
+			link = &(*link)->left;
 		}
 		else {
-			// Convert the root gatorID to a string padded with 0s
-			stringstream idString;
-			idString << setfill('0') << setw(8) << root->gatorID;
-			Remove(idString.str());
-			throw exception();	// Break out of the recursion hierarchy after the desired node has been deleted -- prevents read-access violations
+			bounds.first = (*link)->gatorID;
+			link = &(*link)->right;
 		}
-		RecursiveRemoveInorder(root->right, count);
 	}
+	return link;
+}
+
+void GatorAVL::KeepFinger(GatorNode** link, const pair<int64_t, int64_t>& bounds) {
+	path.push_back(link);
+	pathBounds.push_back(bounds);
+	fingerVersion = version;
 }
 
-void GatorAVL::RecursiveSearch(GatorNode* root, unsigned long gatorID) {	// Referenced pseudocode from Lecture 3a
+void GatorAVL::RecursiveSearch(GatorNode* root, uint32_t gatorID) {	// Referenced pseudocode from Lecture 3a
 	if (!root) {
 		cout << "unsuccessful" << endl;
 	}
 	else if (root->gatorID == gatorID) {
-		cout << root->name << endl;
+		cout << names->Get(root->nameIndex) << endl;
 	}
 	else if (gatorID < root->gatorID) {
 		RecursiveSearch(root->left, gatorID);
@@ -205,18 +422,136 @@ void GatorAVL::RecursiveSearch(GatorNode* root, unsigned long gatorID) {	// Refe
 	}
 }
 
-void GatorAVL::RecursiveSearch(GatorNode* root, string name, bool& found) {
+void GatorAVL::RecursiveSearch(GatorNode* root, uint32_t nameIndex, bool& found) {
 	if (!root) {
 		return;
 	}
 	else {
-		if (root->name == name) {
+		if (root->nameIndex == nameIndex) {	// Interned names are equal exactly when their indices are
 			cout << setfill('0') << setw(8) << root->gatorID << endl;
 			found = true;
 		}
-		RecursiveSearch(root->left, name, found);
-		RecursiveSearch(root->right, name, found);
+		RecursiveSearch(root->left, nameIndex, found);
+		RecursiveSearch(root->right, nameIndex, found);
+	}
+}
+
+void GatorAVL::RecursiveSearch(GatorNode* root, const vector<uint32_t>& matches, int first, int last) {
+	if (first == last) {	// No matches below this node -- every remaining match lies along another branch
+		return;
 	}
+	// Matches are sorted, so the ones smaller than this node belong to its left subtree and the larger ones to its right
+	int middle = lower_bound(matches.begin() + first, matches.begin() + last, root->gatorID) - matches.begin();
+	int rightFirst = middle;
+	if (middle < last && matches[middle] == root->gatorID) {
+		cout << setfill('0') << setw(8) << root->gatorID << endl;
+		rightFirst++;
+	}
+	RecursiveSearch(root->left, matches, first, middle);
+	RecursiveSearch(root->right, matches, rightFirst, last);
+}
+
+void GatorAVL::RecursiveSearch(GatorNode* root, const vector<bool>& nameMatches, vector<uint32_t>& result) {
+	if (!root) {
+		return;
+	}
+	RecursiveSearch(root->left, nameMatches, result);
+	if (nameMatches[root->nameIndex]) {
+		result.push_back(root->gatorID);
+	}
+	RecursiveSearch(root->right, nameMatches, result);
+}
+
+GatorAVL::GatorNode* GatorAVL::FindNearest(uint32_t gatorID, bool above, bool inclusive) {
+	GatorNode* nearest = nullptr;
+	GatorNode* currNode = root;
+	while (currNode) {
+		if (currNode->gatorID == gatorID && inclusive) {
+			return currNode;
+		}
+		if (above) {
+			if (currNode->gatorID > gatorID) {	// A candidate -- anything closer is in its left subtree
+				nearest = currNode;
+				currNode = currNode->left;
+			}
+			else {
+				currNode = currNode->right;
+			}
+		}
+		else {
+			if (currNode->gatorID < gatorID) {
+				nearest = currNode;
+				currNode = currNode->right;
+			}
+			else {
+				currNode = currNode->left;
+			}
+		}
+	}
+	return nearest;
+}
+
+bool GatorAVL::NearestRecord(uint32_t gatorID, bool above, bool inclusive, GatorRecord& record) {
+	GatorNode* nearest = FindNearest(gatorID, above, inclusive);
+	if (!nearest) {
+		return false;
+	}
+	record.name = names->Get(nearest->nameIndex);
+	record.gatorID = nearest->gatorID;
+	return true;
+}
+
+void GatorAVL::PrintNearest(const string& gatorID, bool above, bool inclusive) {
+	uint32_t gatorIDNum;
+	GatorNode* nearest = nullptr;
+	if (ParseGatorID(gatorID, gatorIDNum)) {
+		nearest = FindNearest(gatorIDNum, above, inclusive);
+	}
+	if (!nearest) {
+		cout << "unsuccessful" << endl;
+	}
+	else {
+		cout << setfill('0') << setw(8) << nearest->gatorID << endl;
+	}
+}
+
+int GatorAVL::CountBelow(uint32_t gatorID, bool inclusive) {
+	int count = 0;
+	GatorNode* currNode = root;
+	while (currNode) {
+		if (gatorID < currNode->gatorID || (gatorID == currNode->gatorID && !inclusive)) {
+			currNode = currNode->left;
+		}
+		else {	// currNode and its whole left subtree are counted
+			count++;
+			if (currNode->left) {
+				count += currNode->left->subtreeSize;
+			}
+			currNode = currNode->right;
+		}
+	}
+	return count;
+}
+
+void GatorAVL::RemoveFromNameIndex(GatorNode* root) {
+	if (!root) {
+		return;
+	}
+	nameIndex[root->nameIndex].erase(root->gatorID);
+	RemoveFromNameIndex(root->left);
+	RemoveFromNameIndex(root->right);
+}
+
+void GatorAVL::AddToNameIndex(GatorNode* root) {
+	if (!root) {
+		return;
+	}
+	if (root->nameIndex >= nameIndex.size()) {
+		nameIndex.resize(root->nameIndex + 1);
+	}
+	nameIndex[root->nameIndex].insert(root->gatorID);
+	AddToNameIndex(root->left);
+	AddToNameIndex(root->right);
 }
 
 void GatorAVL::RecursiveInorder(GatorNode* root, vector<string>& result) {	// Referenced code from Lecture 3b
@@ -225,7 +560,7 @@ void GatorAVL::RecursiveInorder(GatorNode* root, vector<string>& result) {	// Re
 	}
 	else {
 		RecursiveInorder(root->left, result);
-		result.push_back(root->name);
+		result.push_back(names->Get(root->nameIndex));
 		RecursiveInorder(root->right, result);
 	}
 }
@@ -235,7 +570,7 @@ void GatorAVL::RecursivePreorder(GatorNode* root, vector<string>& result) {
 		return;
 	}
 	else {
-		result.push_back(root->name);
+		result.push_back(names->Get(root->nameIndex));
 		RecursivePreorder(root->left, result);
 		RecursivePreorder(root->right, result);
 	}
@@ -248,7 +583,7 @@ void GatorAVL::RecursivePostorder(GatorNode* root, vector<string>& result) {
 	else {
 		RecursivePostorder(root->left, result);
 		RecursivePostorder(root->right, result);
-		result.push_back(root->name);
+		result.push_back(names->Get(root->nameIndex));
 	}
 }
 
@@ -256,103 +591,547 @@ void GatorAVL::ClearTree(GatorNode* root) {
 	if (!root) {
 		return;
 	}
+	else if (root->references > 1) {	// A version still uses this subtree, so only the tree's reference is dropped
+		if (nameIndexEnabled) {
+			RemoveFromNameIndex(root);
+		}
+		ReleaseNodes(root, pool.get(), *names);
+	}
 	else {
 		ClearTree(root->left);
 		ClearTree(root->right);
-		delete root;
+		DeleteNode(root);
 	}
 }
 
+GatorAVL::GatorNode* GatorAVL::BuildBalanced(vector<pair<string, uint32_t>>& records, const vector<pair<uint32_t, int>>& sorted, int first, int last, vector<GatorNode*>& built) {
+	if (first == last) {
+		return nullptr;
+	}
+	int middle = first + (last - first) / 2;	// Both halves differ in size by at most one, so the result is perfectly balanced
+	GatorNode* node = NewNode(names->Intern(move(records[sorted[middle].second].first)), sorted[middle].first);
+	built[middle] = node;
+	node->left = BuildBalanced(records, sorted, first, middle, built);
+	node->right = BuildBalanced(records, sorted, middle + 1, last, built);
+	node->height = node->FindHeight();
+	node->subtreeSize = node->FindSubtreeSize();
+	return node;
+}
 
-// GatorAVL public member function definitions:
-GatorAVL::GatorAVL() {
-	size = 0;
-	root = nullptr;
+int GatorAVL::HeightOf(GatorNode* node) {
+	if (!node) {
+		return 0;
+	}
+	return node->height;
 }
 
-GatorAVL::~GatorAVL() {
-	ClearTree(root);
+GatorAVL::GatorNode* GatorAVL::Join(GatorNode* left, GatorNode* middle, GatorNode* right) {	// Referenced the join-based algorithms of Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered Sets"
+	if (HeightOf(left) > HeightOf(right) + 1) {
+		return JoinRight(left, middle, right);
+	}
+	if (HeightOf(right) > HeightOf(left) + 1) {
+		return JoinLeft(left, middle, right);
+	}
+	middle->left = left;
+	middle->right = right;
+	middle->height = middle->FindHeight();
+	middle->subtreeSize = middle->FindSubtreeSize();
+	return middle;
 }
 
-void GatorAVL::Insert(string name, string gatorID) {
-	// The following validation of the gatorID string was made with help from https://stackoverflow.com/questions/49635616/stdstoi-string-with-non-numeric-characters-getting-parsed-as-an-integer-with
-	size_t sizeOfNum = 0;	// Used to compare the parsed number's length to the length of the string (to make sure all characters were able to be parsed -- i.e. they were all digits)
-	long gatorIDNum = 0;
-	try {
-		gatorIDNum = stol(gatorID, &sizeOfNum);
+GatorAVL::GatorNode* GatorAVL::JoinRight(GatorNode* left, GatorNode* middle, GatorNode* right) {
+	if (HeightOf(left) <= HeightOf(right) + 1) {	// Reached a spine node short enough to sit beside right
+		middle->left = left;
+		middle->right = right;
+		middle->height = middle->FindHeight();
+		middle->subtreeSize = middle->FindSubtreeSize();
+		return middle;
 	}
-	catch (invalid_argument) {	// The above try block throws an error if the first character of the gatorID string is not a digit
-		gatorIDNum = -1;	// This will cause the operation to be unsuccessful in the next comparison
+	// Walk down the right spine of the taller tree, rebalancing on the way back up just like an insertion
+	left = Exclusive(left);
+	left->right = JoinRight(left->right, middle, right);
+	left = BalanceNode(left);
+	left->height = left->FindHeight();
+	left->subtreeSize = left->FindSubtreeSize();
+	return left;
+}
+
+GatorAVL::GatorNode* GatorAVL::JoinLeft(GatorNode* left, GatorNode* middle, GatorNode* right) {
+	if (HeightOf(right) <= HeightOf(left) + 1) {
+		middle->left = left;
+		middle->right = right;
+		middle->height = middle->FindHeight();
+		middle->subtreeSize = middle->FindSubtreeSize();
+		return middle;
 	}
-	if (gatorID.length() != 8 || sizeOfNum != gatorID.length() || gatorIDNum < 0) {
-		cout << "unsuccessful" << endl;
+	right = Exclusive(right);
+	right->left = JoinLeft(left, middle, right->left);
+	right = BalanceNode(right);
+	right->height = right->FindHeight();
+	right->subtreeSize = right->FindSubtreeSize();
+	return right;
+}
+
+GatorAVL::GatorNode* GatorAVL::SplitTree(GatorNode* root, uint32_t gatorID, GatorNode*& left, GatorNode*& right) {
+	if (!root) {
+		left = nullptr;
+		right = nullptr;
+		return nullptr;
+	}
+	root = Exclusive(root);
+	GatorNode* subtreeLeft = root->left;	// Read before Join() reuses root as a middle node
+	GatorNode* subtreeRight = root->right;
+	if (gatorID < root->gatorID) {	// root and its right subtree belong entirely to the right side
+		GatorNode* splitRight;
+		GatorNode* found = SplitTree(subtreeLeft, gatorID, left, splitRight);
+		right = Join(splitRight, root, subtreeRight);
+		return found;
+	}
+	else if (gatorID > root->gatorID) {
+		GatorNode* splitLeft;
+		GatorNode* found = SplitTree(subtreeRight, gatorID, splitLeft, right);
+		left = Join(subtreeLeft, root, splitLeft);
+		return found;
+	}
+	left = subtreeLeft;
+	right = subtreeRight;
+	root->left = nullptr;
+	root->right = nullptr;
+	root->height = 1;
+	root->subtreeSize = 1;
+	return root;
+}
+
+GatorAVL::GatorNode* GatorAVL::SplitLast(GatorNode* root, GatorNode*& last) {
+	root = Exclusive(root);
+	if (!root->right) {
+		last = root;
+		return root->left;
+	}
+	GatorNode* subtreeLeft = root->left;
+	GatorNode* rest = SplitLast(root->right, last);
+	return Join(subtreeLeft, root, rest);
+}
+
+GatorAVL::GatorNode* GatorAVL::JoinTrees(GatorNode* left, GatorNode* right) {
+	if (!left) {
+		return right;
+	}
+	if (!right) {
+		return left;
+	}
+	GatorNode* last;
+	GatorNode* rest = SplitLast(left, last);
+	return Join(rest, last, right);
+}
+
+GatorAVL::GatorNode* GatorAVL::CopySubtree(GatorAVL& source, GatorNode* node) {
+	if (!node) {
+		return nullptr;
+	}
+	GatorNode* copy = NewNode(names->Intern(source.names->Get(node->nameIndex)), node->gatorID);
+	copy->left = CopySubtree(source, node->left);
+	copy->right = CopySubtree(source, node->right);
+	copy->height = node->height;
+	copy->subtreeSize = node->subtreeSize;
+	return copy;
+}
+
+const int parallelCutoff = 4096;	// Subproblems with fewer nodes than this are not worth handing to another thread
+
+template <typename LeftTask, typename RightTask>
+void GatorAVL::Fork(GatorThreadPool* threads, int work, LeftTask leftTask, RightTask rightTask) {
+	if (!threads || work < parallelCutoff) {
+		leftTask();
+		rightTask();
 		return;
 	}
+	atomic<int> pending(0);
+	threads->Submit(rightTask, pending);
+	leftTask();
+	threads->Wait(pending);		// The tasks capture locals of the caller by reference, so it must not return before both finish
+}
+
+GatorAVL::GatorNode* GatorAVL::UnionTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads) {
+	if (!first) {
+		return second;
+	}
+	if (!second) {
+		return first;
+	}
+	second = Exclusive(second);
+	// Split first around second's root, then merge each side with the matching half of second
+	int work = first->subtreeSize + second->subtreeSize;
+	GatorNode* firstLeft;
+	GatorNode* firstRight;
+	GatorNode* existing = SplitTree(first, second->gatorID, firstLeft, firstRight);
+	GatorNode* left;
+	GatorNode* right;
+	vector<GatorNode*> rightDiscarded;
+	Fork(threads, work,
+		[&] { left = UnionTrees(firstLeft, second->left, discarded, threads); },
+		[&] { right = UnionTrees(firstRight, second->right, rightDiscarded, threads); });
+	discarded.insert(discarded.end(), rightDiscarded.begin(), rightDiscarded.end());
+	if (existing) {		// The gatorID is in both trees -- keep first's record
+		second->left = nullptr;
+		second->right = nullptr;
+		discarded.push_back(second);
+		return Join(left, existing, right);
+	}
+	return Join(left, second, right);
+}
+
+GatorAVL::GatorNode* GatorAVL::IntersectTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads) {
+	if (!first || !second) {	// Nothing left to match, so whichever side remains is dropped whole
+		if (first) {
+			discarded.push_back(first);
+		}
+		if (second) {
+			discarded.push_back(second);
+		}
+		return nullptr;
+	}
+	second = Exclusive(second);
+	int work = first->subtreeSize + second->subtreeSize;
+	GatorNode* firstLeft;
+	GatorNode* firstRight;
+	GatorNode* existing = SplitTree(first, second->gatorID, firstLeft, firstRight);
+	GatorNode* left;
+	GatorNode* right;
+	vector<GatorNode*> rightDiscarded;
+	Fork(threads, work,
+		[&] { left = IntersectTrees(firstLeft, second->left, discarded, threads); },
+		[&] { right = IntersectTrees(firstRight, second->right, rightDiscarded, threads); });
+	discarded.insert(discarded.end(), rightDiscarded.begin(), rightDiscarded.end());
+	second->left = nullptr;
+	second->right = nullptr;
+	discarded.push_back(second);
+	if (existing) {
+		return Join(left, existing, right);
+	}
+	return JoinTrees(left, right);
+}
+
+GatorAVL::GatorNode* GatorAVL::DifferenceTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads) {
+	if (!first || !second) {
+		if (second) {
+			discarded.push_back(second);
+		}
+		return first;
+	}
+	second = Exclusive(second);
+	int work = first->subtreeSize + second->subtreeSize;
+	GatorNode* firstLeft;
+	GatorNode* firstRight;
+	GatorNode* existing = SplitTree(first, second->gatorID, firstLeft, firstRight);
+	GatorNode* left;
+	GatorNode* right;
+	vector<GatorNode*> rightDiscarded;
+	Fork(threads, work,
+		[&] { left = DifferenceTrees(firstLeft, second->left, discarded, threads); },
+		[&] { right = DifferenceTrees(firstRight, second->right, rightDiscarded, threads); });
+	discarded.insert(discarded.end(), rightDiscarded.begin(), rightDiscarded.end());
+	second->left = nullptr;
+	second->right = nullptr;
+	discarded.push_back(second);
+	if (existing) {		// SplitTree() already detached it
+		discarded.push_back(existing);
+	}
+	return JoinTrees(left, right);
+}
+
+GatorAVL::GatorNode* GatorAVL::TakeTree(GatorAVL& other) {
+	GatorNode* tree = other.root;
+	if (other.pool != pool || other.names != names) {
+		tree = CopySubtree(other, other.root);
+		other.ClearTree(other.root);
+	}
+	other.root = nullptr;
+	other.size = 0;
+	if (other.nameIndexEnabled) {
+		other.SetNameIndex(true);
+	}
+	return tree;
+}
+
+GatorAVL::GatorStatus GatorAVL::SetOperation(GatorAVL& other, unsigned int threads, GatorNode* (GatorAVL::*operation)(GatorNode*, GatorNode*, vector<GatorNode*>&, GatorThreadPool*)) {
+	if (&other == this) {
+		return GatorStatus::Invalid;
+	}
+	BeginUpdate();
+	other.BeginUpdate();
+	if (GetVersionCount() > 0 || other.GetVersionCount() > 0) {		// Copying shared nodes allocates, and the pool is not thread-safe
+		threads = 1;
+	}
+	bool indexed = nameIndexEnabled;
+	nameIndexEnabled = false;	// Nodes move between the trees, so the index is rebuilt once at the end instead
+	GatorNode* second = TakeTree(other);
+	vector<GatorNode*> discarded;
+	if (threads > 1) {
+		GatorThreadPool workers(threads);
+		root = (this->*operation)(root, second, discarded, &workers);
+	}
+	else {
+		root = (this->*operation)(root, second, discarded, nullptr);
+	}
+	for (int i = 0; i < discarded.size(); i++) {	// The pool and name table are not shared between threads, so nodes are only freed here
+		ClearTree(discarded[i]);
+	}
+	size = root ? root->subtreeSize : 0;
+	if (indexed) {
+		SetNameIndex(true);
+	}
+	return GatorStatus::Successful;
+}
+
+bool GatorAVL::ParseGatorID(const string& gatorID, uint32_t& gatorIDNum) {
+	if (gatorID.length() != 8) {
+		return false;
+	}
+	uint32_t parsed = 0;
+	for (int i = 0; i < 8; i++) {	// Every character has to be a digit -- no signs or whitespace
+		if (gatorID[i] < '0' || gatorID[i] > '9') {
+			return false;
+		}
+		parsed = parsed * 10 + (gatorID[i] - '0');
+	}
+	gatorIDNum = parsed;
+	return true;
+}
+
+bool GatorAVL::ValidName(const string& name) {
 	for (int i = 0; i < name.length(); i++) {
 		if (!isalpha(name[i]) && name[i] != ' ') {
-			cout << "unsuccessful" << endl;
-			return;
+			return false;
 		}
 	}
-	try {
-		root = RecursiveInsert(root, name, gatorIDNum);
+	return true;
+}
+
+GatorAVL::GatorStatus GatorAVL::PrintStatus(GatorStatus status) {
+	if (status == GatorStatus::Successful) {
+		cout << "successful" << endl;
 	}
-	catch (exception) {	// Will execute in the case of duplicate IDs
+	else {
 		cout << "unsuccessful" << endl;
-		return;
 	}
-	size++;
-	cout << "successful" << endl;
+	return status;
 }
 
-void GatorAVL::Remove(string gatorID) {
-	size_t sizeOfNum = 0;
-	long gatorIDNum = 0;
-	try {
-		gatorIDNum = stol(gatorID, &sizeOfNum);
+// GatorAVL public member function definitions:
+GatorAVL::GatorAVL(unsigned int poolChunkSize) {
+	size = 0;
+	lastTouched = 0;
+	stableDepth = 0;
+	version = 1;
+	fingerVersion = 0;	// No finger until the first finger operation
+	nameIndexEnabled = false;
+	root = nullptr;
+	names = make_shared<GatorNameTable>();
+	versions = make_shared<VersionQueue>();
+	if (poolChunkSize > 0) {
+		pool = make_shared<GatorNodePool<GatorNode>>(poolChunkSize);
 	}
-	catch (invalid_argument) {
-		gatorIDNum = -1;
+}
+
+GatorAVL::~GatorAVL() {
+	nameIndexEnabled = false;	// Skip updating the index while every node is deleted
+	// Pooled nodes own nothing outside the pool, so there is no need to visit them one by one -- unless another tree still uses the pool or names
+	if (!pool || pool.use_count() > 1 || names.use_count() > 1) {
+		ClearTree(root);
 	}
-	if (gatorID.length() != 8 || sizeOfNum != gatorID.length() || gatorIDNum < 0) {
-		cout << "unsuccessful" << endl;
-		return;
+	DetachVersions();
+}
+
+GatorAVL::GatorStatus GatorAVL::Insert(const string& name, const string& gatorID) {
+	uint32_t gatorIDNum;
+	if (!ParseGatorID(gatorID, gatorIDNum)) {
+		return PrintStatus(GatorStatus::Invalid);
 	}
-	try {
-		root = RecursiveRemove(root, gatorIDNum);
+	return PrintStatus(InsertName(name, gatorIDNum));
+}
+
+GatorAVL::GatorStatus GatorAVL::Insert(string&& name, const string& gatorID) {
+	uint32_t gatorIDNum;
+	if (!ParseGatorID(gatorID, gatorIDNum)) {
+		return PrintStatus(GatorStatus::Invalid);
 	}
-	catch (exception) {		// Will execute in the case that the input gatorID is not found in the tree
-		cout << "unsuccessful" << endl;
-		return;
+	return PrintStatus(InsertName(move(name), gatorIDNum));
+}
+
+GatorAVL::GatorStatus GatorAVL::Remove(const string& gatorID) {
+	uint32_t gatorIDNum;
+	if (!ParseGatorID(gatorID, gatorIDNum)) {
+		return PrintStatus(GatorStatus::Invalid);
+	}
+	return PrintStatus(Remove(gatorIDNum));
+}
+
+GatorAVL::GatorStatus GatorAVL::Insert(const string& name, uint32_t gatorID) {
+	return InsertName(name, gatorID);
+}
+
+GatorAVL::GatorStatus GatorAVL::Remove(uint32_t gatorID) {
+	if (gatorID > 99999999) {
+		return GatorStatus::Invalid;
+	}
+	if (!IterativeRemove(gatorID)) {	// The input gatorID is not found in the tree
+		return GatorStatus::NotFound;
 	}
 	size--;
-	cout << "successful" << endl;
+	return GatorStatus::Successful;
+}
+
+bool GatorAVL::Search(uint32_t gatorID, GatorRecord& record) {
+	GatorNode* currNode = root;
+	while (currNode) {
+		if (gatorID < currNode->gatorID) {
+			currNode = currNode->left;
+		}
+		else if (gatorID > currNode->gatorID) {
+			currNode = currNode->right;
+		}
+		else {
+			record.name = names->Get(currNode->nameIndex);
+			record.gatorID = gatorID;
+			return true;
+		}
+	}
+	return false;
+}
+
+vector<GatorAVL::GatorStatus> GatorAVL::InsertBatch(vector<pair<string, uint32_t>> records) {
+	BeginUpdate();
+	vector<GatorStatus> statuses(records.size(), GatorStatus::Invalid);
+	vector<pair<uint32_t, int>> sorted;		// gatorID and position in records of every valid record
+	sorted.reserve(records.size());
+	for (int i = 0; i < records.size(); i++) {
+		if (records[i].second <= 99999999 && ValidName(records[i].first)) {		// gatorIDs have 8 digits at most
+			sorted.push_back(make_pair(records[i].second, i));
+		}
+	}
+	if (!is_sorted(sorted.begin(), sorted.end())) {
+		sort(sorted.begin(), sorted.end());		// Equal gatorIDs stay in input order, so the first one is kept just as Insert() would
+	}
+	int unique = 0;
+	for (int i = 0; i < sorted.size(); i++) {
+		if (unique > 0 && sorted[unique - 1].first == sorted[i].first) {
+			statuses[sorted[i].second] = GatorStatus::Duplicate;
+		}
+		else {
+			statuses[sorted[i].second] = GatorStatus::Successful;
+			sorted[unique] = sorted[i];
+			unique++;
+		}
+	}
+	sorted.resize(unique);
+	bool indexed = nameIndexEnabled;
+	nameIndexEnabled = false;	// A batch node may turn out to be a duplicate, so only the ones that survive the union are indexed
+	vector<GatorNode*> built(unique);	// The node built for each entry of sorted
+	GatorNode* batch = BuildBalanced(records, sorted, 0, unique, built);
+	nameIndexEnabled = indexed;
+	vector<GatorNode*> duplicates;	// Batch nodes whose gatorIDs were already in the tree
+	root = UnionTrees(root, batch, duplicates, nullptr);
+	for (int i = 0; i < duplicates.size(); i++) {
+		int position = lower_bound(sorted.begin(), sorted.end(), make_pair(duplicates[i]->gatorID, 0)) - sorted.begin();
+		statuses[sorted[position].second] = GatorStatus::Duplicate;
+		built[position] = nullptr;
+		FreeNode(duplicates[i], pool.get(), *names);	// Never indexed, so the index entry of the record it collided with stays
+	}
+	if (nameIndexEnabled) {		// Every batch node still in built is in the tree now
+		for (int i = 0; i < built.size(); i++) {
+			if (built[i]) {
+				if (built[i]->nameIndex >= nameIndex.size()) {
+					nameIndex.resize(built[i]->nameIndex + 1);
+				}
+				nameIndex[built[i]->nameIndex].insert(built[i]->gatorID);
+			}
+		}
+	}
+	size = root ? root->subtreeSize : 0;
+	return statuses;
+}
+
+vector<GatorAVL::GatorStatus> GatorAVL::BulkLoad(vector<pair<string, string>> records) {
+	vector<pair<string, uint32_t>> parsed;
+	parsed.reserve(records.size());
+	for (int i = 0; i < records.size(); i++) {
+		uint32_t gatorIDNum;
+		if (!ParseGatorID(records[i].second, gatorIDNum)) {
+			gatorIDNum = 100000000;		// Too long to be a gatorID, so InsertBatch() reports the record as invalid
+		}
+		parsed.push_back(make_pair(move(records[i].first), gatorIDNum));
+	}
+	return InsertBatch(move(parsed));
+}
+
+int GatorAVL::RemoveRange(uint32_t low, uint32_t high) {
+	BeginUpdate();
+	if (low > high || !root) {
+		return 0;
+	}
+	GatorNode* lower;
+	GatorNode* rest;
+	GatorNode* found = SplitTree(root, low, lower, rest);
+	GatorNode* middle;
+	GatorNode* higher;
+	GatorNode* last = SplitTree(rest, high, middle, higher);
+	if (found) {	// Both bounds are inclusive, so the nodes holding them are removed too
+		middle = Join(nullptr, found, middle);
+	}
+	if (last) {
+		middle = Join(middle, last, nullptr);
+	}
+	root = JoinTrees(lower, higher);
+	if (!middle) {
+		return 0;
+	}
+	int removed = middle->subtreeSize;
+	ClearTree(middle);
+	size -= removed;
+	return removed;
+}
+
+GatorAVL::GatorStatus GatorAVL::RemoveRange(const string& low, const string& high) {
+	uint32_t lowNum;
+	uint32_t highNum;
+	if (!ParseGatorID(low, lowNum) || !ParseGatorID(high, highNum)) {
+		return PrintStatus(GatorStatus::Invalid);
+	}
+	if (RemoveRange(lowNum, highNum) == 0) {
+		return PrintStatus(GatorStatus::NotFound);
+	}
+	return PrintStatus(GatorStatus::Successful);
 }
 
 void GatorAVL::Search(string term) {
 	if (!isdigit(term[0])) {	// Search for a name
-		for (int i = 0; i < term.length(); i++) {
-			if (!isalpha(term[i]) && term[i] != ' ') {
-				cout << "unsuccessful" << endl;
-				return;
-			}
+		if (!ValidName(term)) {
+			cout << "unsuccessful" << endl;
+			return;
 		}
 		bool found = false;		// Passed as a reference to keep track of matches across the recursive hierarchy
-		RecursiveSearch(root, term, found);
+		uint32_t nameIndex;
+		if (names->Find(term, nameIndex)) {	// A name that was never interned cannot match any node
+			if (nameIndexEnabled) {
+				vector<uint32_t> matches;
+				if (nameIndex < this->nameIndex.size()) {	// Names interned by a tree sharing the table (or kept by a version) may have no slot here
+					matches.assign(this->nameIndex[nameIndex].begin(), this->nameIndex[nameIndex].end());
+				}
+				RecursiveSearch(root, matches, 0, matches.size());
+				found = !matches.empty();
+			}
+			else {
+				RecursiveSearch(root, nameIndex, found);
+			}
+		}
 		if (!found) {
 			cout << "unsuccessful" << endl;
 		}
 	}
 	else {	// Search for a gatorID
-		size_t sizeOfNum = 0;
-		long gatorIDNum = 0;
-		try {
-			gatorIDNum = stol(term, &sizeOfNum);
-		}
-		catch (invalid_argument) {
-			gatorIDNum = -1;
-		}
-		if (term.length() != 8 || sizeOfNum != term.length() || gatorIDNum < 0) {
+		uint32_t gatorIDNum;
+		if (!ParseGatorID(term, gatorIDNum)) {
 			cout << "unsuccessful" << endl;
 			return;
 		}
@@ -360,6 +1139,62 @@ void GatorAVL::Search(string term) {
 	}
 }
 
+void GatorAVL::SearchPrefix(const string& prefix) {
+	if (!ValidName(prefix)) {
+		cout << "unsuccessful" << endl;
+		return;
+	}
+	vector<uint32_t> result = FindPrefix(prefix);
+	if (result.empty()) {
+		cout << "unsuccessful" << endl;
+	}
+	for (int i = 0; i < result.size(); i++) {
+		cout << setfill('0') << setw(8) << result[i] << endl;
+	}
+}
+
+void GatorAVL::SearchRange(const string& low, const string& high) {
+	uint32_t lowNum;
+	uint32_t highNum;
+	if (!ParseGatorID(low, lowNum) || !ParseGatorID(high, highNum)) {
+		cout << "unsuccessful" << endl;
+		return;
+	}
+	bool found = false;
+	ForEachInRange(lowNum, highNum, [&found](uint32_t gatorID, const string&) {
+		cout << setfill('0') << setw(8) << gatorID << endl;
+		found = true;
+	});
+	if (!found) {
+		cout << "unsuccessful" << endl;
+	}
+}
+
+vector<uint32_t> GatorAVL::FindPrefix(const string& prefix) {
+	vector<uint32_t> matchingNames;
+	names->FindPrefix(prefix, matchingNames);
+	vector<uint32_t> result;
+	if (matchingNames.empty()) {
+		return result;
+	}
+	if (nameIndexEnabled) {		// Gather the gatorIDs straight from the index
+		for (int i = 0; i < matchingNames.size(); i++) {
+			if (matchingNames[i] < nameIndex.size()) {		// A name with no slot is not used by this tree
+				result.insert(result.end(), nameIndex[matchingNames[i]].begin(), nameIndex[matchingNames[i]].end());
+			}
+		}
+		sort(result.begin(), result.end());
+	}
+	else {	// Without the index every node has to be checked -- an inorder walk keeps the result sorted
+		vector<bool> nameMatches(names->GetCapacity());
+		for (int i = 0; i < matchingNames.size(); i++) {
+			nameMatches[matchingNames[i]] = true;
+		}
+		RecursiveSearch(root, nameMatches, result);
+	}
+	return result;
+}
+
 void GatorAVL::Inorder() {
 	vector<string> result;	// Vector to store the ordered names
 	RecursiveInorder(root, result);
@@ -404,28 +1239,334 @@ void GatorAVL::PrintLevelCount() {
 		cout << "0" << endl;
 	}
 	else {
-		cout << root->height << endl;
+		cout << (int)root->height << endl;
+	}
+}
+
+void GatorAVL::PrintNameStats() {
+	cout << names->GetCount() << " distinct names, " << names->GetReferenceCount() << " references (dedup ratio " << names->GetDedupRatio() << "), " << names->GetBytesSaved() << " bytes saved" << endl;
+}
+
+GatorAVL::GatorStatus GatorAVL::RemoveInorder(int index) {
+	if (index < 0 || index >= (int)size) {	// Index is invalid
+		return PrintStatus(GatorStatus::NotFound);
+	}
+	IterativeRemoveInorder(index);
+	size--;
+	return PrintStatus(GatorStatus::Successful);
+}
+
+void GatorAVL::SetNameIndex(bool enabled) {
+	nameIndex.clear();
+	nameIndexEnabled = enabled;
+	if (enabled) {
+		AddToNameIndex(root);
+	}
+}
+
+void GatorAVL::PrintRank(string gatorID) {
+	uint32_t gatorIDNum;
+	int rank = -1;
+	if (ParseGatorID(gatorID, gatorIDNum)) {
+		rank = RankOf(gatorIDNum);
+	}
+	if (rank < 0) {
+		cout << "unsuccessful" << endl;
+	}
+	else {
+		cout << rank << endl;
 	}
 }
 
-void GatorAVL::RemoveInorder(int index) {
-	if (index > size - 1 || index < 0) {	// Index is invalid
+void GatorAVL::PrintSelect(int index) {
+	GatorRecord record;
+	if (!SelectByRank(index, record)) {
 		cout << "unsuccessful" << endl;
-		return;
 	}
-	try {
-		RecursiveRemoveInorder(root, index);
+	else {
+		cout << setfill('0') << setw(8) << record.gatorID << endl;
+	}
+}
+
+bool GatorAVL::SelectByRank(int index, GatorRecord& record) {
+	if (index < 0 || index >= (int)size) {
+		return false;
+	}
+	GatorNode* currNode = root;
+	while (true) {
+		int leftSize = 0;
+		if (currNode->left) {
+			leftSize = currNode->left->subtreeSize;
+		}
+		if (index < leftSize) {
+			currNode = currNode->left;
+		}
+		else if (index > leftSize) {	// Skip the left subtree and this node
+			index -= leftSize + 1;
+			currNode = currNode->right;
+		}
+		else {
+			record.name = names->Get(currNode->nameIndex);
+			record.gatorID = currNode->gatorID;
+			return true;
+		}
+	}
+}
+
+int GatorAVL::RankOf(uint32_t gatorID) {
+	int rank = 0;	// Number of nodes passed on the way down that are smaller than gatorID
+	GatorNode* currNode = root;
+	while (currNode) {
+		int leftSize = 0;
+		if (currNode->left) {
+			leftSize = currNode->left->subtreeSize;
+		}
+		if (gatorID < currNode->gatorID) {
+			currNode = currNode->left;
+		}
+		else if (gatorID > currNode->gatorID) {
+			rank += leftSize + 1;
+			currNode = currNode->right;
+		}
+		else {
+			return rank + leftSize;
+		}
 	}
-	catch (exception) {		// An exception is thrown if the value at index is removed successfully
+	return -1;
+}
+
+bool GatorAVL::LowerBound(uint32_t gatorID, GatorRecord& record) {
+	return NearestRecord(gatorID, true, true, record);
+}
+
+bool GatorAVL::UpperBound(uint32_t gatorID, GatorRecord& record) {
+	return NearestRecord(gatorID, true, false, record);
+}
+
+bool GatorAVL::Predecessor(uint32_t gatorID, GatorRecord& record) {
+	return NearestRecord(gatorID, false, false, record);
+}
+
+bool GatorAVL::Successor(uint32_t gatorID, GatorRecord& record) {
+	return NearestRecord(gatorID, true, false, record);
+}
+
+void GatorAVL::PrintLowerBound(const string& gatorID) {
+	PrintNearest(gatorID, true, true);
+}
+
+void GatorAVL::PrintUpperBound(const string& gatorID) {
+	PrintNearest(gatorID, true, false);
+}
+
+void GatorAVL::PrintPredecessor(const string& gatorID) {
+	PrintNearest(gatorID, false, false);
+}
+
+void GatorAVL::PrintSuccessor(const string& gatorID) {
+	PrintNearest(gatorID, true, false);
+}
+
+GatorAVL::GatorStatus GatorAVL::FingerInsert(const string& name, const string& gatorID) {
+	uint32_t gatorIDNum;
+	if (!ParseGatorID(gatorID, gatorIDNum) || !ValidName(name)) {
+		return PrintStatus(GatorStatus::Invalid);
+	}
+	ReclaimVersions();	// Unlike BeginUpdate(), this keeps the finger
+	pair<int64_t, int64_t> bounds;
+	GatorNode** link = FingerLink(gatorIDNum, bounds);
+	if (*link) {
+		KeepFinger(link, bounds);
+		return PrintStatus(GatorStatus::Duplicate);
+	}
+	link = UnsharePath(link);
+	InsertAtPath(link, NewNode(names->Intern(name), gatorIDNum));
+	size++;
+	if (stableDepth == path.size()) {	// No rotation, so the path still leads to the new node
+		KeepFinger(link, bounds);
+	}
+	else {	// Keep the part of the path above the rotation -- it covers the same gatorIDs as before
+		path.resize(stableDepth);
+		pathBounds.resize(stableDepth);
+		fingerVersion = version;
+	}
+	return PrintStatus(GatorStatus::Successful);
+}
+
+bool GatorAVL::FingerSearch(uint32_t gatorID, GatorRecord& record) {
+	pair<int64_t, int64_t> bounds;
+	GatorNode** link = FingerLink(gatorID, bounds);
+	KeepFinger(link, bounds);
+	if (!*link) {
+		return false;
+	}
+	record.name = names->Get((*link)->nameIndex);
+	record.gatorID = gatorID;
+	return true;
+}
+
+int GatorAVL::CountRange(uint32_t low, uint32_t high) {
+	if (low > high) {
+		return 0;
+	}
+	return CountBelow(high, true) - CountBelow(low, false);
+}
+
+void GatorAVL::PrintCountRange(const string& low, const string& high) {
+	uint32_t lowNum;
+	uint32_t highNum;
+	if (!ParseGatorID(low, lowNum) || !ParseGatorID(high, highNum)) {
+		cout << "unsuccessful" << endl;
+	}
+	else {
+		cout << CountRange(lowNum, highNum) << endl;
+	}
+}
+
+void GatorAVL::Compact() {
+	BeginUpdate();
+	if (!pool || !root || GetVersionCount() > 0) {	// Versions point at the nodes where they are now
 		return;
 	}
-	cout << "unsuccessful" << endl;
+	shared_ptr<GatorNodePool<GatorNode>> packed = make_shared<GatorNodePool<GatorNode>>(pool->GetChunkSize());
+	packed->Reserve(size);
+	// Copy the nodes level by level so that the top of the tree (visited by every search) shares cache lines
+	vector<pair<GatorNode*, GatorNode**>> queue;	// Each node paired with the link in the new tree that should point to its copy
+	queue.reserve(size);
+	GatorNode* newRoot = nullptr;
+	queue.push_back(make_pair(root, &newRoot));
+	for (int i = 0; i < queue.size(); i++) {
+		GatorNode* node = queue[i].first;
+		GatorNode* copy = packed->Allocate(move(*node));
+		*queue[i].second = copy;
+		if (node->left) {
+			queue.push_back(make_pair(node->left, &copy->left));
+		}
+		if (node->right) {
+			queue.push_back(make_pair(node->right, &copy->right));
+		}
+		pool->Free(node);
+	}
+	pool = packed;	// Frees every chunk of the old pool at once, unless a tree split from this one still uses it
+	root = newRoot;
+}
+
+GatorAVL::GatorStatus GatorAVL::Split(uint32_t gatorID, GatorAVL& upper, bool shareStorage) {
+	if (&upper == this || upper.root) {
+		return GatorStatus::Invalid;
+	}
+	BeginUpdate();
+	upper.BeginUpdate();
+	if (shareStorage) {
+		upper.ShareStorage(*this);
+	}
+	else if (upper.pool == pool || upper.names == names) {	// Shared since an earlier split, so upper starts over with storage of its own
+		upper.DetachVersions();
+		upper.versions = make_shared<VersionQueue>();
+		upper.names = make_shared<GatorNameTable>();
+		if (upper.pool) {
+			upper.pool = make_shared<GatorNodePool<GatorNode>>(upper.pool->GetChunkSize());
+		}
+	}
+	GatorNode* lower;
+	GatorNode* higher;
+	GatorNode* found = SplitTree(root, gatorID, lower, higher);
+	if (found) {	// The split point itself belongs to the upper tree
+		higher = Join(nullptr, found, higher);
+	}
+	root = lower;
+	size = root ? root->subtreeSize : 0;
+	if (!shareStorage) {
+		GatorNode* copy = upper.CopySubtree(*this, higher);
+		ClearTree(higher);
+		higher = copy;
+	}
+	upper.root = higher;
+	upper.size = higher ? higher->subtreeSize : 0;
+	if (nameIndexEnabled) {
+		SetNameIndex(true);
+	}
+	if (upper.nameIndexEnabled) {
+		upper.SetNameIndex(true);
+	}
+	return GatorStatus::Successful;
+}
+
+GatorAVL::GatorStatus GatorAVL::ShareStorage(GatorAVL& other) {
+	if (&other == this || root) {
+		return GatorStatus::Invalid;
+	}
+	BeginUpdate();
+	AttachVersions(other.versions);		// Releases this tree's own versions while it still has the storage they came from
+	pool = other.pool;
+	names = other.names;
+	if (nameIndexEnabled) {		// Indexed by the old name table
+		SetNameIndex(true);
+	}
+	return GatorStatus::Successful;
+}
+
+GatorAVL::GatorStatus GatorAVL::Join(GatorAVL& upper) {
+	if (&upper == this) {
+		return GatorStatus::Invalid;
+	}
+	if (!upper.root) {
+		return GatorStatus::Successful;
+	}
+	BeginUpdate();
+	upper.BeginUpdate();
+	if (root) {		// The key ranges must not overlap: compare this tree's largest gatorID with upper's smallest
+		GatorNode* largest = root;
+		while (largest->right) {
+			largest = largest->right;
+		}
+		GatorNode* smallest = upper.root;
+		while (smallest->left) {
+			smallest = smallest->left;
+		}
+		if (largest->gatorID >= smallest->gatorID) {
+			return GatorStatus::Invalid;
+		}
+	}
+	root = JoinTrees(root, TakeTree(upper));
+	size = root->subtreeSize;
+	if (nameIndexEnabled) {
+		SetNameIndex(true);
+	}
+	return GatorStatus::Successful;
+}
+
+GatorAVL::GatorStatus GatorAVL::Union(GatorAVL& other, unsigned int threads) {
+	return SetOperation(other, threads, &GatorAVL::UnionTrees);
+}
+
+GatorAVL::GatorStatus GatorAVL::Intersection(GatorAVL& other, unsigned int threads) {
+	return SetOperation(other, threads, &GatorAVL::IntersectTrees);
+}
+
+GatorAVL::GatorStatus GatorAVL::Difference(GatorAVL& other, unsigned int threads) {
+	return SetOperation(other, threads, &GatorAVL::DifferenceTrees);
+}
+
+shared_ptr<const GatorAVL::Version> GatorAVL::Snapshot() {
+	ReclaimVersions();
+	Share(root);	// The version's reference -- the next update that reaches the root copies it
+	versions->live++;
+	return shared_ptr<const Version>(new Version(root, size, pool, names, versions));
+}
+
+int GatorAVL::GetVersionCount() {
+	return versions->live;
 }
 
 GatorAVL::GatorNode* GatorAVL::GetRoot() {
 	return root;
 }
 
+string GatorAVL::GetName(GatorNode* node) {
+	return names->Get(node->nameIndex);
+}
+
 int GatorAVL::GetSize() {
 	return size;
 }
@@ -437,4 +1578,56 @@ int GatorAVL::GetLevelCount() {
 	else {
 		return root->height;
 	}
+}
+
+int GatorAVL::GetLastTouchCount() {
+	return lastTouched;
+}
+
+
+// VersionQueue and Version function definitions:
+GatorAVL::VersionQueue::VersionQueue() {
+	live = 0;
+	trees = 1;	// The tree that creates the queue
+}
+
+GatorAVL::Version::Version(GatorNode* root, unsigned int size, shared_ptr<GatorNodePool<GatorNode>> pool, shared_ptr<GatorNameTable> names, shared_ptr<VersionQueue> versions) {
+	this->root = root;
+	this->size = size;
+	this->pool = pool;
+	this->names = names;
+	this->versions = versions;
+}
+
+GatorAVL::Version::~Version() {
+	lock_guard<mutex> guard(versions->lock);
+	if (versions->trees == 0) {		// No tree is left to release the nodes on its next update
+		ReleaseNodes(root, pool.get(), *names);
+		versions->live--;
+	}
+	else {
+		versions->released.push_back(root);
+	}
+}
+
+bool GatorAVL::Version::Find(uint32_t gatorID, GatorRecord& record) const {
+	GatorNode* currNode = root;
+	while (currNode) {
+		if (gatorID < currNode->gatorID) {
+			currNode = currNode->left;
+		}
+		else if (gatorID > currNode->gatorID) {
+			currNode = currNode->right;
+		}
+		else {
+			record.name = names->Get(currNode->nameIndex);
+			record.gatorID = gatorID;
+			return true;
+		}
+	}
+	return false;
+}
+
+int GatorAVL::Version::GetSize() const {
+	return size;
 }
\ No newline at end of file
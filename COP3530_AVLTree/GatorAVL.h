@@ -1,29 +1,91 @@
+#pragma once
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <ctype.h>
 #include <iomanip>
 #include <vector>
+#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "GatorNodePool.h"
+#include "GatorNameTable.h"
+#include "GatorThreadPool.h"
 
 using namespace std;
 
 class GatorAVL {
-	struct GatorNode {
-		string name;
-		unsigned long gatorID;
-		int height;
+	struct GatorNode {	// Only holds the fields needed on the search path -- the name itself lives in the tree's GatorNameTable
+		uint32_t gatorID;	// gatorIDs are exactly 8 decimal digits, so they fit in 27 bits
+		uint32_t nameIndex;
+		uint32_t subtreeSize;	// Number of nodes in the subtree rooted here (including this one)
+		uint8_t height;		// An AVL tree of height 255 would need more nodes than can be addressed
+		uint16_t references;	// Parents and snapshots pointing here (fits in what was padding) -- a node with more than one is copied before it changes
 		GatorNode* left;
 		GatorNode* right;
 
-		GatorNode(string name = "default_name", unsigned long gatorID = 0, int height = 1, GatorNode* left = nullptr, GatorNode* right = nullptr);
+		GatorNode(uint32_t nameIndex = 0, uint32_t gatorID = 0, int height = 1, GatorNode* left = nullptr, GatorNode* right = nullptr);
 		int FindHeight();	// Return an invoking node's height value (used to update the height member variable)
 		int FindBF(); // Return an invoking node's balance factor
+		int FindSubtreeSize();	// Return an invoking node's subtree size (used to update the subtreeSize member variable)
+	};
+
+public:
+	struct GatorRecord {	// Copy of one record handed back by the query functions
+		string name;
+		uint32_t gatorID;
 	};
 
+	enum class GatorStatus {	// Outcome of an operation that changes the tree
+		Successful,
+		Invalid,	// The name or gatorID was malformed
+		Duplicate,	// The gatorID is already in the tree
+		NotFound	// The gatorID or index does not exist in the tree
+	};
+
+	class Version;
+
 private:
 	// Private member variables:
 	unsigned int size;
 	GatorNode* root;
+	// Trees produced by Split() share their node pool and name table (unsynchronized), so nodes can move between them without being copied
+	shared_ptr<GatorNodePool<GatorNode>> pool;	// Null when nodes are allocated individually on the heap
+	shared_ptr<GatorNameTable> names;
+	// Snapshots handed back by their last owner, possibly on another thread -- they are released by the next update on the tree
+	struct VersionQueue {
+		mutex lock;
+		vector<GatorNode*> released;	// Roots of versions that are no longer used
+		atomic<int> live;	// Versions taken and not yet released -- while it is 0 no node is shared, so updates skip the checks
+		int trees;	// Trees sharing this queue -- once none are left a version releases its nodes itself
+		VersionQueue();
+	};
+	shared_ptr<VersionQueue> versions;
+	bool nameIndexEnabled;
+	vector<set<uint32_t>> nameIndex;	// gatorIDs using each interned name, indexed by nameIndex -- only kept while nameIndexEnabled is set
+	vector<GatorNode**> path;	// Links from the root down to the node being inserted or removed (reused between operations)
+	int lastTouched;	// Number of ancestors the last insertion or removal had to rebalance
+	int stableDepth;	// Number of links at the top of path that the last Retrace() left pointing at unchanged subtrees
+	// After a finger operation, path ends at the node it reached and pathBounds holds the open gatorID interval covered by each link on it
+	vector<pair<int64_t, int64_t>> pathBounds;
+	unsigned long version;	// Bumped by every operation that reuses path or relinks nodes
+	unsigned long fingerVersion;	// The version when the finger in path was last valid
+
+	GatorNode* NewNode(uint32_t nameIndex, uint32_t gatorID);	// Allocate a node from the pool (or the heap if there is no pool)
+	void DeleteNode(GatorNode* node);	// Return a node to wherever NewNode() allocated it from
+	static void FreeNode(GatorNode* node, GatorNodePool<GatorNode>* pool, GatorNameTable& names);	// DeleteNode() without touching the name index
+	// Snapshot support -- every node that an update changes must have a single reference, so shared nodes are copied first:
+	static void Share(GatorNode* node);		// Count one more reference (a count that reaches its limit stays there and the node is never freed)
+	GatorNode* Exclusive(GatorNode* node);	// Return node, or a copy of it that the caller now owns in its place if it is shared
+	GatorNode** UnsharePath(GatorNode** link);	// Make every node on path and the one at link exclusive, returning link's new address
+	static void ReleaseNodes(GatorNode* node, GatorNodePool<GatorNode>* pool, GatorNameTable& names);	// Drop a reference to a version's subtree
+	void ReclaimVersions();		// Release the versions that were handed back since the last update
+	void BeginUpdate();		// Invalidate the finger and call ReclaimVersions()
+	void DetachVersions();	// Stop using the version queue, leaving versions still in use to release themselves if no other tree shares it
+	void AttachVersions(shared_ptr<VersionQueue> queue);	// Start sharing another tree's version queue (along with its pool and name table)
 
 	GatorNode* RotateLeft(GatorNode* root);
 	GatorNode* RotateRight(GatorNode* root);
@@ -31,32 +93,191 @@ private:
 	GatorNode* RotateRightLeft(GatorNode* root);
 
 	GatorNode* BalanceNode(GatorNode* node);	// Check if the invoking node is balanced -- if not, make necessary rotations and return the node it was replaced by
-	GatorNode* RecursiveInsert(GatorNode* root, string name, unsigned long gatorID);	// Helper function for Insert()
-	GatorNode* RecursiveRemove(GatorNode* root, unsigned long gatorID);		// Helper function for Remove()
-	void RecursiveRemoveInorder(GatorNode* root, int& count);
+	// Insertion and removal walk down once, recording the links they pass through in path, then retrace upward:
+	GatorNode** FindLink(uint32_t gatorID);	// Return the link that holds (or would hold) a gatorID, recording its ancestors on path
+	void InsertAtPath(GatorNode** link, GatorNode* node);	// Attach a new node at an empty link found by FindLink()
+	template <typename Name>
+	GatorStatus InsertName(Name&& name, uint32_t gatorID);	// Helper function for Insert() -- forwards the name so it is copied at most once
+	bool IterativeRemove(uint32_t gatorID);		// Helper function for Remove() -- returns false if the gatorID is not in the tree
+	void IterativeRemoveInorder(int index);		// Helper function for RemoveInorder() -- descends by subtree sizes
+	void RemoveAtPath(GatorNode** link);	// Unlink the node that link points to, with its ancestors' links already on path
+	void Retrace();		// Rebalance the nodes on path from the bottom up, stopping once a subtree's height is unchanged
+	GatorNode** FingerLink(uint32_t gatorID, pair<int64_t, int64_t>& bounds);	// FindLink() that climbs from the finger instead of starting at the root
+	void KeepFinger(GatorNode** link, const pair<int64_t, int64_t>& bounds);	// Leave path ending at link for the next finger operation
 	// Helper functions for Search():
-	void RecursiveSearch(GatorNode* root, unsigned long gatorID);
-	void RecursiveSearch(GatorNode* root, string name, bool& found);
+	void RecursiveSearch(GatorNode* root, uint32_t gatorID);
+	void RecursiveSearch(GatorNode* root, uint32_t nameIndex, bool& found);
+	void RecursiveSearch(GatorNode* root, const vector<uint32_t>& matches, int first, int last);	// Print matches[first, last) in preorder, visiting only their ancestors
+	void RecursiveSearch(GatorNode* root, const vector<bool>& nameMatches, vector<uint32_t>& result);	// Collect the gatorIDs of every node whose name is marked in nameMatches
+	template <typename Callback>
+	static void RecursiveRange(GatorNode* root, uint32_t low, uint32_t high, GatorNameTable& names, Callback& callback);	// Helper function for ForEachInRange() -- skips subtrees outside [low, high]
+	void RemoveFromNameIndex(GatorNode* root);	// Remove every node of a subtree from the name index
+	// Helper functions for the nearest-record queries -- one descent that remembers the last candidate passed:
+	GatorNode* FindNearest(uint32_t gatorID, bool above, bool inclusive);	// Closest node above (or below) gatorID, or gatorID itself if inclusive
+	bool NearestRecord(uint32_t gatorID, bool above, bool inclusive, GatorRecord& record);
+	void PrintNearest(const string& gatorID, bool above, bool inclusive);
+	int CountBelow(uint32_t gatorID, bool inclusive);	// Number of gatorIDs below (or, if inclusive, at most) gatorID, found from subtree sizes in one descent
+	void AddToNameIndex(GatorNode* root);	// Add every node of a subtree to the name index
 	// Helper functions for traversals:
 	void RecursiveInorder(GatorNode* root, vector<string>& result);
 	void RecursivePreorder(GatorNode* root, vector<string>& result);
 	void RecursivePostorder(GatorNode* root, vector<string>& result);
 
 	void ClearTree(GatorNode* root);	// Delete each node in the tree
+	// Helper functions for InsertBatch():
+	GatorNode* BuildBalanced(vector<pair<string, uint32_t>>& records, const vector<pair<uint32_t, int>>& sorted, int first, int last, vector<GatorNode*>& built);	// built[i] gets the node for sorted[i]
+	// Join-based building blocks -- each runs in time proportional to the difference in height of the trees involved:
+	int HeightOf(GatorNode* node);
+	GatorNode* Join(GatorNode* left, GatorNode* middle, GatorNode* right);	// Concatenate left, middle and right, which must already be in increasing gatorID order
+	GatorNode* JoinRight(GatorNode* left, GatorNode* middle, GatorNode* right);		// Helper function for Join() when left is taller
+	GatorNode* JoinLeft(GatorNode* left, GatorNode* middle, GatorNode* right);		// Helper function for Join() when right is taller
+	GatorNode* SplitTree(GatorNode* root, uint32_t gatorID, GatorNode*& left, GatorNode*& right);	// Split into gatorIDs below and above gatorID, returning the detached node holding gatorID (if any)
+	GatorNode* SplitLast(GatorNode* root, GatorNode*& last);	// Detach the node with the largest gatorID and return what remains of the tree
+	GatorNode* JoinTrees(GatorNode* left, GatorNode* right);	// Concatenate two trees without a middle node, using left's largest node as the middle
+	GatorNode* CopySubtree(GatorAVL& source, GatorNode* node);	// Copy a subtree of another tree into this tree's pool and name table, keeping its shape
+	// Join-based set operations on two trees sharing this tree's storage -- the halves left and right of the second tree's root
+	// run as separate tasks when threads is not null, so nodes to delete are collected in discarded and freed afterwards
+	GatorNode* UnionTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads);	// first wins on equal gatorIDs
+	GatorNode* IntersectTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads);	// Keeps first's nodes
+	GatorNode* DifferenceTrees(GatorNode* first, GatorNode* second, vector<GatorNode*>& discarded, GatorThreadPool* threads);
+	template <typename LeftTask, typename RightTask>
+	void Fork(GatorThreadPool* threads, int work, LeftTask leftTask, RightTask rightTask);	// Run both tasks, in parallel if there is a pool and enough work
+	GatorNode* TakeTree(GatorAVL& other);	// Detach other's tree, copying it into this tree's storage if the two do not share it
+	GatorStatus SetOperation(GatorAVL& other, unsigned int threads, GatorNode* (GatorAVL::*operation)(GatorNode*, GatorNode*, vector<GatorNode*>&, GatorThreadPool*));
+	bool ParseGatorID(const string& gatorID, uint32_t& gatorIDNum);	// Validate an 8-digit gatorID string and convert it to a number
+	bool ValidName(const string& name);		// Names may only contain letters and spaces
+	GatorStatus PrintStatus(GatorStatus status);	// Print "successful" or "unsuccessful" and pass the status through
 
 public:
-	GatorAVL();
+	GatorAVL(unsigned int poolChunkSize = 1024);	// A chunk size of 0 disables the node pool and uses new/delete for every node
 	~GatorAVL();
-	void Insert(string name, string gatorID);
-	void Remove(string gatorID);
+	GatorStatus Insert(const string& name, const string& gatorID);
+	GatorStatus Insert(string&& name, const string& gatorID);		// Moves the name into the tree instead of copying it
+	template <typename... Args>
+	GatorStatus EmplaceInsert(const string& gatorID, Args&&... nameArgs) {		// Construct the name directly from the arguments of a string constructor
+		return Insert(string(forward<Args>(nameArgs)...), gatorID);
+	}
+	GatorStatus Remove(const string& gatorID);
+	// Insert(), Remove() and Search() without printing, for callers that check the result themselves:
+	GatorStatus Insert(const string& name, uint32_t gatorID);
+	GatorStatus Remove(uint32_t gatorID);
+	bool Search(uint32_t gatorID, GatorRecord& record);		// Find the record with a gatorID -- returns false if it is not in the tree
+	// Cut every gatorID in [low, high] out with two splits and a join, then free the removed nodes -- O(log n + k)
+	int RemoveRange(uint32_t low, uint32_t high);	// Returns the number of records removed
+	GatorStatus RemoveRange(const string& low, const string& high);		// Prints "unsuccessful" if a bound is malformed or nothing was removed
+	// Insert (name, gatorID) records, returning the status of each in input order
+	// The batch is sorted (unless it already is), built into a balanced tree in O(m) and merged into the existing tree by split/join
+	// in O(m log(n / m + 1)) -- an empty tree is built directly
+	vector<GatorStatus> InsertBatch(vector<pair<string, uint32_t>> records);
+	vector<GatorStatus> BulkLoad(vector<pair<string, string>> records);		// InsertBatch() with gatorIDs still in string form
 	void Search(string term);		// Search for a name or gatorID
+	void SearchPrefix(const string& prefix);	// Print the gatorIDs of every name starting with prefix, in increasing order
+	vector<uint32_t> FindPrefix(const string& prefix);		// Return the sorted gatorIDs of every name starting with prefix
+	// Call callback(gatorID, name) for every record with low <= gatorID <= high, in increasing order of gatorID, in O(log n + k)
+	template <typename Callback>
+	void ForEachInRange(uint32_t low, uint32_t high, Callback callback) {
+		RecursiveRange(root, low, high, *names, callback);
+	}
+	void SearchRange(const string& low, const string& high);	// Print the gatorIDs in [low, high] in increasing order
 	void Inorder();
 	void Preorder();
 	void Postorder();
 	void PrintLevelCount();
-	void RemoveInorder(int index);
+	void PrintNameStats();	// Report how well duplicate names are being shared
+	void SetNameIndex(bool enabled);	// Keep a map from each name to its gatorIDs so name searches do not visit every node
+	GatorStatus RemoveInorder(int index);
+	void PrintRank(string gatorID);		// Print the inorder index of a gatorID
+	void PrintSelect(int index);	// Print the gatorID at an inorder index
+	bool SelectByRank(int index, GatorRecord& record);	// Find the record at an inorder index -- returns false if the index is out of bounds
+	int RankOf(uint32_t gatorID);	// Return the inorder index of a gatorID, or -1 if it is not in the tree
+	// Nearest-record queries in O(log n) -- each returns false if there is no such record:
+	bool LowerBound(uint32_t gatorID, GatorRecord& record);		// Smallest gatorID >= gatorID
+	bool UpperBound(uint32_t gatorID, GatorRecord& record);		// Smallest gatorID > gatorID
+	bool Predecessor(uint32_t gatorID, GatorRecord& record);	// Largest gatorID < gatorID
+	bool Successor(uint32_t gatorID, GatorRecord& record);		// Next record after gatorID (the same as UpperBound(), named for walking the tree)
+	void PrintLowerBound(const string& gatorID);
+	void PrintUpperBound(const string& gatorID);
+	void PrintPredecessor(const string& gatorID);
+	void PrintSuccessor(const string& gatorID);
+	// Finger operations keep the path of the previous one and climb only until the gatorID falls inside a subtree on it, then descend from
+	// there -- a gatorID d records away costs O(log d) comparisons when the finger's subtree brackets it, O(log n) in the worst case, since two
+	// neighbors can sit on opposite sides of the root (ancestors above still have their sizes updated)
+	GatorStatus FingerInsert(const string& name, const string& gatorID);	// Insert() starting from the finger
+	bool FingerSearch(uint32_t gatorID, GatorRecord& record);	// Find the record with a gatorID starting from the finger -- returns false if it is not in the tree
+	int CountRange(uint32_t low, uint32_t high);	// Number of gatorIDs in [low, high], in O(log n) without visiting the records in between
+	void PrintCountRange(const string& low, const string& high);
+	// Relocate every node into one contiguous block in breadth-first order, so the top levels that every search visits share cache lines
+	// Only the placement changes -- links stay pointers, so each node is as large as before -- and nothing is moved while versions are held
+	void Compact();
+	// Move every gatorID >= gatorID into upper, which must be empty
+	// By default upper takes the nodes in O(log n) and shares this tree's pool and name table afterwards -- neither is synchronized,
+	// so the two trees must not be updated from different threads at the same time
+	// Without shareStorage the k records moved are copied into storage of upper's own in O(k) more, so each tree can go to its own thread
+	GatorStatus Split(uint32_t gatorID, GatorAVL& upper, bool shareStorage = true);
+	// Make this tree, which must be empty, use other's pool and name table, as Split() does -- Join() and the set operations between the two
+	// then move nodes instead of copying them, and the same rule holds: the two trees must not be updated from different threads at the same time
+	GatorStatus ShareStorage(GatorAVL& other);
+	// Move every record of upper, whose gatorIDs must all be larger than this tree's, to the end of this tree, leaving upper empty
+	// This takes O(log n) when the trees share storage (as after Split()) -- otherwise upper's records are copied over first
+	// Either operation rebuilds the name index of a tree that has it enabled
+	GatorStatus Join(GatorAVL& upper);
+	// Set operations that leave the result in this tree and empty other, in O(m log(n / m + 1)) work for trees of n and m records
+	// With more than one thread the recursion is split across a thread pool (polylogarithmic span)
+	// Records of other are copied first if the trees do not share storage, and the name index is rebuilt if enabled
+	GatorStatus Union(GatorAVL& other, unsigned int threads = 1);	// This tree's record wins when both have a gatorID
+	GatorStatus Intersection(GatorAVL& other, unsigned int threads = 1);	// Keep this tree's records whose gatorIDs are also in other
+	GatorStatus Difference(GatorAVL& other, unsigned int threads = 1);	// Keep this tree's records whose gatorIDs are not in other
+	// Take an immutable view of the tree in O(1) -- later updates copy the O(log n) nodes they change instead of changing them in place
+	// A version can be read and dropped on any thread, even while the tree keeps changing
+	shared_ptr<const Version> Snapshot();
+	int GetVersionCount();	// Versions taken and not yet released
 	// Accessor functions to aid with testing:
 	GatorNode* GetRoot();
+	string GetName(GatorNode* node);
 	int GetSize();
 	int GetLevelCount();
-};
\ No newline at end of file
+	int GetLastTouchCount();
+};
+
+// Read-only view of a GatorAVL as it was when Snapshot() was called -- nothing the tree does afterwards shows through
+class GatorAVL::Version {
+	friend class GatorAVL;
+
+private:
+	GatorNode* root;
+	unsigned int size;
+	// Shared with the tree, so the nodes and names stay valid even if the tree is destroyed first
+	shared_ptr<GatorNodePool<GatorNode>> pool;
+	shared_ptr<GatorNameTable> names;
+	shared_ptr<VersionQueue> versions;
+
+	Version(GatorNode* root, unsigned int size, shared_ptr<GatorNodePool<GatorNode>> pool, shared_ptr<GatorNameTable> names, shared_ptr<VersionQueue> versions);
+
+public:
+	~Version();		// Hands the root back to the tree, or frees what only this version used if no tree is left
+	Version(const Version&) = delete;
+	Version& operator=(const Version&) = delete;
+	bool Find(uint32_t gatorID, GatorRecord& record) const;		// Returns false if the gatorID was not in the tree
+	template <typename Callback>
+	void ForEachInRange(uint32_t low, uint32_t high, Callback callback) const {
+		RecursiveRange(root, low, high, *names, callback);
+	}
+	int GetSize() const;
+};
+
+template <typename Callback>
+void GatorAVL::RecursiveRange(GatorNode* root, uint32_t low, uint32_t high, GatorNameTable& names, Callback& callback) {
+	while (root) {
+		if (root->gatorID < low) {	// Everything on the left is below the range too
+			root = root->right;
+		}
+		else if (root->gatorID > high) {
+			root = root->left;
+		}
+		else {
+			RecursiveRange(root->left, low, high, names, callback);
+			callback(root->gatorID, names.Get(root->nameIndex));
+			root = root->right;		// Continue with the right subtree in place of a second recursive call
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,662 @@
+// Standalone benchmark driver -- build it on its own with GatorAVL.cpp (it is not part of the Catch test project)
+// Usage: GatorAVL_Bench <benchmark> [arguments]
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include "GatorAVL.h"
+#include "LockedGatorAVL.h"
+#include "ConcurrentGatorAVL.h"
+
+// Every heap allocation made by the process, counted by the replacement operator new below -- atomic, since the concurrent benchmarks
+// allocate from many threads (relaxed, since it is only read once those threads are joined)
+atomic<size_t> allocationCount(0);
+
+void* operator new(size_t bytes) {
+	allocationCount.fetch_add(1, memory_order_relaxed);
+	void* memory = malloc(bytes ? bytes : 1);
+	if (!memory) {
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	free(memory);
+}
+
+// Silences the "successful"/"unsuccessful" output of the tree while an operation is being timed
+struct QuietOutput {
+	streambuf* saved;
+	QuietOutput() {
+		saved = cout.rdbuf(nullptr);
+	}
+	~QuietOutput() {
+		cout.rdbuf(saved);
+		cout.clear();
+	}
+};
+
+double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+long ResidentKB() {	// Current resident set size of the process (only available on Linux)
+	ifstream status("/proc/self/status");
+	string line;
+	while (getline(status, line)) {
+		if (line.compare(0, 6, "VmRSS:") == 0) {
+			return stol(line.substr(6));
+		}
+	}
+	return -1;
+}
+
+vector<string> ShuffledIDs(int count, unsigned int seed = 3530) {	// Distinct 8-digit gatorIDs in random order
+	vector<string> ids;
+	ids.reserve(count);
+	unsigned long step = 89999999 / count;
+	for (int i = 0; i < count; i++) {
+		stringstream idString;
+		idString << 10000000 + i * step;
+		ids.push_back(idString.str());
+	}
+	shuffle(ids.begin(), ids.end(), mt19937(seed));
+	return ids;
+}
+
+// insert <heap|pool> <count>: inserts/sec and RSS growth when nodes come from the heap or from the node pool
+void BenchInsert(int argc, char** argv) {
+	bool usePool = argc < 3 || string(argv[2]) != "heap";
+	int count = argc < 4 ? 1000000 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(count);
+	long rssBefore = ResidentKB();
+
+	GatorAVL avlTree(usePool ? 1024 : 0);
+	auto start = chrono::steady_clock::now();
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert("testname", ids[i]);
+		}
+	}
+	double elapsed = Seconds(start);
+	cout << (usePool ? "pool" : "heap") << ": " << count << " inserts in " << elapsed << " s (" << count / elapsed << " inserts/sec), RSS +" << ResidentKB() - rssBefore << " KB" << endl;
+}
+
+// Average number of nodes and of distinct 64-byte cache lines visited by a search for each of ids
+template <typename Node>
+void MeasureSearchPaths(Node* root, const vector<string>& ids, double& nodes, double& lines) {
+	long nodeTotal = 0;
+	long lineTotal = 0;
+	for (int i = 0; i < ids.size(); i++) {
+		uint32_t gatorID = stoul(ids[i]);
+		vector<uintptr_t> seen;
+		for (Node* node = root; node; node = gatorID < node->gatorID ? node->left : node->right) {
+			uintptr_t line = reinterpret_cast<uintptr_t>(node) / 64;
+			if (find(seen.begin(), seen.end(), line) == seen.end()) {
+				seen.push_back(line);
+			}
+			nodeTotal++;
+			if (node->gatorID == gatorID) {
+				break;
+			}
+		}
+		lineTotal += seen.size();
+	}
+	nodes = (double)nodeTotal / ids.size();
+	lines = (double)lineTotal / ids.size();
+}
+
+// lookup <count> [compact]: lookups/sec for IDs that are present (name printed) and absent (search path only),
+// and the node size and cache lines touched per search, set against 32-bit index links (two 4-byte links in place of two pointers)
+void BenchLookup(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	bool compact = argc >= 4 && string(argv[3]) == "compact";
+	vector<string> ids = ShuffledIDs(count);
+
+	GatorAVL avlTree;
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert("testname", ids[i]);
+		}
+	}
+	if (compact) {
+		avlTree.Compact();
+	}
+	shuffle(ids.begin(), ids.end(), mt19937(42));
+	size_t nodeBytes = sizeof(*avlTree.GetRoot());
+	size_t indexNodeBytes = nodeBytes - 2 * (sizeof(avlTree.GetRoot()->left) - sizeof(uint32_t));
+	double pathNodes;
+	double pathLines;
+	MeasureSearchPaths(avlTree.GetRoot(), ids, pathNodes, pathLines);
+	cout << "node: " << nodeBytes << " bytes (" << 64.0 / nodeBytes << " per cache line), " << indexNodeBytes << " bytes with 32-bit index links (" << 64.0 / indexNodeBytes << " per cache line)" << endl;
+	cout << (compact ? "compacted, " : "as inserted, ") << "search path: " << pathNodes << " nodes over " << pathLines << " cache lines" << endl;
+	vector<string> missing;		// ShuffledIDs() spaces its IDs apart, so one past each of them is never in the tree
+	missing.reserve(count);
+	for (int i = 0; i < count; i++) {
+		missing.push_back(to_string(stol(ids[i]) + 1));
+	}
+	for (int pass = 0; pass < 2; pass++) {
+		vector<string>& terms = pass == 0 ? ids : missing;
+		auto start = chrono::steady_clock::now();
+		{
+			QuietOutput quiet;
+			for (int i = 0; i < count; i++) {
+				avlTree.Search(terms[i]);
+			}
+		}
+		double elapsed = Seconds(start);
+		cout << (compact ? "compacted, " : "as inserted, ") << (pass == 0 ? "hits: " : "misses: ") << count << " lookups in " << elapsed << " s (" << count / elapsed << " lookups/sec)" << endl;
+	}
+}
+
+// retrace <count>: average number of ancestors rebalanced per insert and remove, compared with the height of the tree
+void BenchRetrace(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	vector<string> ids = ShuffledIDs(count);
+
+	GatorAVL avlTree;
+	double insertTouched = 0;
+	double removeTouched = 0;
+	auto start = chrono::steady_clock::now();
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert("testname", ids[i]);
+			insertTouched += avlTree.GetLastTouchCount();
+		}
+	}
+	double insertTime = Seconds(start);
+	int levels = avlTree.GetLevelCount();
+	start = chrono::steady_clock::now();
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count / 2; i++) {
+			avlTree.Remove(ids[i]);
+			removeTouched += avlTree.GetLastTouchCount();
+		}
+	}
+	double removeTime = Seconds(start);
+	cout << count << " keys, " << levels << " levels" << endl;
+	cout << "insert: " << insertTouched / count << " ancestors touched on average, " << count / insertTime << " inserts/sec" << endl;
+	cout << "remove: " << removeTouched / (count / 2) << " ancestors touched on average, " << (count / 2) / removeTime << " removes/sec" << endl;
+}
+
+// allocs <count> <distinct names>: heap allocations per insert for names too long for the small-string buffer
+void BenchAllocations(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int distinct = argc < 4 ? 100 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(count);
+	vector<string> names;
+	for (int i = 0; i < distinct; i++) {
+		string suffix;
+		for (int n = i; suffix.empty() || n > 0; n /= 26) {
+			suffix += (char)('a' + n % 26);
+		}
+		names.push_back("Alexandria Montgomery " + suffix);
+	}
+
+	GatorAVL avlTree;
+	size_t before = allocationCount.load(memory_order_relaxed);
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert(names[i % distinct], ids[i]);
+		}
+	}
+	size_t allocations = allocationCount.load(memory_order_relaxed) - before;
+	cout << count << " inserts with " << distinct << " distinct names: " << allocations << " allocations (" << (double)allocations / count << " per insert)" << endl;
+}
+
+// mix <count> <miss percent>: remove throughput when a share of the removes target IDs that are not in the tree
+// Each remove that hits is followed by re-inserting the same record, so the tree keeps its size
+void BenchMissMix(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int missPercent = argc < 4 ? 30 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(count);
+
+	GatorAVL avlTree;
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert("testname", ids[i]);
+		}
+	}
+	mt19937 random(7);
+	vector<string> terms;
+	vector<bool> hits;
+	for (int i = 0; i < count; i++) {
+		string id = ids[random() % count];
+		bool hit = (int)(random() % 100) >= missPercent;
+		terms.push_back(hit ? id : to_string(stol(id) + 1));	// ShuffledIDs() spaces its IDs apart, so one past each of them is never in the tree
+		hits.push_back(hit);
+	}
+	auto start = chrono::steady_clock::now();
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Remove(terms[i]);
+			if (hits[i]) {
+				avlTree.Insert("testname", terms[i]);
+			}
+		}
+	}
+	double elapsed = Seconds(start);
+	cout << count << " removes (" << missPercent << "% misses) in " << elapsed << " s (" << count / elapsed << " removes/sec)" << endl;
+}
+
+// prefix <count> <distinct names> [index]: time per prefix search by full scan, or with the name index
+void BenchPrefix(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int distinct = argc < 4 ? 10000 : stoi(argv[3]);
+	bool useIndex = argc >= 5 && string(argv[4]) == "index";
+	vector<string> ids = ShuffledIDs(count);
+	mt19937 random(11);
+	vector<string> names;
+	for (int i = 0; i < distinct; i++) {
+		string name(1, (char)('A' + random() % 26));
+		for (int j = 0; j < 7; j++) {
+			name += (char)('a' + random() % 26);
+		}
+		names.push_back(name);
+	}
+
+	GatorAVL avlTree;
+	avlTree.SetNameIndex(useIndex);
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert(names[random() % distinct], ids[i]);
+		}
+	}
+	int queries = 20;
+	unsigned long matches = 0;
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		string prefix = names[random() % distinct].substr(0, 2);	// About 1 in 676 names share a two-letter prefix
+		matches += avlTree.FindPrefix(prefix).size();
+	}
+	double elapsed = Seconds(start);
+	cout << (useIndex ? "name index" : "full scan") << ", " << count << " records: " << elapsed / queries * 1000 << " ms per prefix search (" << matches / queries << " matches on average)" << endl;
+}
+
+// batch <tree size> <batch size>: one InsertBatch() of unsorted records into an existing tree, compared with one Insert() per record
+void BenchBatch(int argc, char** argv) {
+	int treeSize = argc < 3 ? 1000000 : stoi(argv[2]);
+	int batchSize = argc < 4 ? 100000 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(treeSize + batchSize);
+	vector<pair<string, uint32_t>> batch;
+	for (int i = treeSize; i < treeSize + batchSize; i++) {
+		batch.push_back(make_pair("testname", (uint32_t)stoul(ids[i])));
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		GatorAVL avlTree;
+		{
+			QuietOutput quiet;
+			for (int i = 0; i < treeSize; i++) {
+				avlTree.Insert("testname", ids[i]);
+			}
+		}
+		auto start = chrono::steady_clock::now();
+		if (pass == 0) {
+			QuietOutput quiet;
+			for (int i = treeSize; i < treeSize + batchSize; i++) {
+				avlTree.Insert("testname", ids[i]);
+			}
+		}
+		else {
+			avlTree.InsertBatch(batch);
+		}
+		double elapsed = Seconds(start);
+		cout << (pass == 0 ? "Insert: " : "InsertBatch: ") << batchSize << " records into " << treeSize << " in " << elapsed << " s (" << batchSize / elapsed << " records/sec)" << endl;
+	}
+}
+
+// count <count> <range width>: CountRange() from subtree sizes against counting the same ranges with a pruned walk
+void BenchCount(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int width = argc < 4 ? 1000000 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(count);
+	GatorAVL avlTree;
+	{
+		QuietOutput quiet;
+		for (int i = 0; i < count; i++) {
+			avlTree.Insert("testname", ids[i]);
+		}
+	}
+	mt19937 random(5);
+	int queries = 1000;
+	vector<uint32_t> lows;
+	for (int i = 0; i < queries; i++) {
+		lows.push_back(10000000 + random() % (89999999 - width));
+	}
+	for (int pass = 0; pass < 2; pass++) {
+		unsigned long total = 0;
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < queries; i++) {
+			if (pass == 0) {
+				avlTree.ForEachInRange(lows[i], lows[i] + width, [&total](uint32_t, const string&) { total++; });
+			}
+			else {
+				total += avlTree.CountRange(lows[i], lows[i] + width);
+			}
+		}
+		double elapsed = Seconds(start);
+		cout << (pass == 0 ? "range walk: " : "CountRange: ") << elapsed / queries * 1000000 << " us per query (" << total / queries << " records per range on average)" << endl;
+	}
+}
+
+// finger <count> <sequential|clustered|random>: Insert() and Search() against FingerInsert() and FingerSearch() over one stream of gatorIDs
+// A clustered stream visits blocks of 64 consecutive gatorIDs in random order
+void BenchFinger(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	string pattern = argc < 4 ? "sequential" : argv[3];
+	vector<string> ids;
+	for (int i = 0; i < count; i++) {
+		ids.push_back(to_string(10000000 + i));
+	}
+	if (pattern == "random") {
+		shuffle(ids.begin(), ids.end(), mt19937(3530));
+	}
+	else if (pattern == "clustered") {
+		vector<int> blocks;
+		for (int i = 0; i < count; i += 64) {
+			blocks.push_back(i);
+		}
+		shuffle(blocks.begin(), blocks.end(), mt19937(3530));
+		vector<string> clustered;
+		for (int i = 0; i < blocks.size(); i++) {
+			for (int j = blocks[i]; j < blocks[i] + 64 && j < count; j++) {
+				clustered.push_back(ids[j]);
+			}
+		}
+		ids = clustered;
+	}
+	vector<uint32_t> searchIDs;
+	for (int i = 0; i < count; i++) {
+		searchIDs.push_back(stoul(ids[i]));
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		GatorAVL avlTree;
+		auto start = chrono::steady_clock::now();
+		{
+			QuietOutput quiet;
+			for (int i = 0; i < count; i++) {
+				if (pass == 0) {
+					avlTree.Insert("testname", ids[i]);
+				}
+				else {
+					avlTree.FingerInsert("testname", ids[i]);
+				}
+			}
+		}
+		double insertTime = Seconds(start);
+		GatorAVL::GatorRecord record;
+		unsigned long found = 0;
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < count; i++) {
+			if (pass == 0) {
+				found += avlTree.RankOf(searchIDs[i]) >= 0;		// The same root-first descent as Search(), without printing the name
+			}
+			else {
+				found += avlTree.FingerSearch(searchIDs[i], record);
+			}
+		}
+		double searchTime = Seconds(start);
+		cout << pattern << (pass == 0 ? ", from the root: " : ", from the finger: ") << count / insertTime << " inserts/sec, " << found / searchTime << " lookups/sec" << endl;
+	}
+}
+
+// setops <count> [max threads]: Union(), Intersection() and Difference() of two trees of count records (half of them shared)
+// with 1, 2, 4, ... up to max threads (32 by default) -- once for trees sharing storage, and once for independent trees whose second
+// tree is copied into the first one's storage as part of the operation
+void BenchSetOperations(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	unsigned int maxThreads = argc < 4 ? 32 : stoi(argv[3]);
+	vector<string> ids = ShuffledIDs(count + count / 2);
+	vector<pair<string, uint32_t>> firstRecords;
+	vector<pair<string, uint32_t>> secondRecords;
+	for (int i = 0; i < count; i++) {
+		firstRecords.push_back(make_pair("registrar", (uint32_t)stoul(ids[i])));
+		secondRecords.push_back(make_pair("housing", (uint32_t)stoul(ids[count / 2 + i])));
+	}
+	const char* operations[] = { "union", "intersection", "difference" };
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		for (int shared = 1; shared >= 0; shared--) {
+			cout << threads << (threads == 1 ? " thread, " : " threads, ") << (shared ? "shared storage: " : "independent trees: ");
+			for (int operation = 0; operation < 3; operation++) {
+				GatorAVL first;
+				first.InsertBatch(firstRecords);
+				GatorAVL second;
+				if (shared) {
+					second.ShareStorage(first);
+				}
+				second.InsertBatch(secondRecords);
+				auto start = chrono::steady_clock::now();
+				if (operation == 0) {
+					first.Union(second, threads);
+				}
+				else if (operation == 1) {
+					first.Intersection(second, threads);
+				}
+				else {
+					first.Difference(second, threads);
+				}
+				cout << operations[operation] << " " << Seconds(start) << " s" << (operation < 2 ? ", " : "");
+			}
+			cout << endl;
+		}
+	}
+}
+
+// Baseline for rwmix: the same tree behind one plain mutex, so queries wait for each other as well as for updates
+class MutexGatorAVL {
+private:
+	GatorAVL tree;
+	mutex lock;
+
+public:
+	vector<GatorAVL::GatorStatus> InsertBatch(vector<pair<string, uint32_t>> records) {
+		lock_guard<mutex> guard(lock);
+		return tree.InsertBatch(move(records));
+	}
+
+	GatorAVL::GatorStatus Insert(const string& name, uint32_t gatorID) {
+		lock_guard<mutex> guard(lock);
+		return tree.Insert(name, gatorID);
+	}
+
+	GatorAVL::GatorStatus Remove(uint32_t gatorID) {
+		lock_guard<mutex> guard(lock);
+		return tree.Remove(gatorID);
+	}
+
+	bool Search(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+		lock_guard<mutex> guard(lock);
+		return tree.Search(gatorID, record);
+	}
+};
+
+template <typename Tree>
+void RunReadWriteMix(int count, int readPercent, unsigned int maxThreads) {
+	const int operations = 200000;	// Per thread
+	vector<string> ids = ShuffledIDs(count);
+	vector<pair<string, uint32_t>> records;
+	for (int i = 0; i < count; i++) {
+		records.push_back(make_pair("registrar", (uint32_t)stoul(ids[i])));
+	}
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		Tree avlTree;
+		avlTree.InsertBatch(records);
+		atomic<long> reads(0);
+		vector<thread> workers;
+		auto start = chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threads; t++) {
+			workers.push_back(thread([&avlTree, &records, &reads, readPercent, t] {
+				mt19937 random(t);
+				long threadReads = 0;
+				GatorAVL::GatorRecord record;
+				for (int i = 0; i < operations; i++) {
+					const pair<string, uint32_t>& target = records[random() % records.size()];
+					if (random() % 100 < readPercent) {
+						avlTree.Search(target.second, record);
+						threadReads++;
+					}
+					else {	// Remove a record and put it back, so the tree keeps its size
+						avlTree.Remove(target.second);
+						avlTree.Insert(target.first, target.second);
+					}
+				}
+				reads += threadReads;
+			}));
+		}
+		for (unsigned int t = 0; t < threads; t++) {
+			workers[t].join();
+		}
+		double seconds = Seconds(start);
+		cout << threads << (threads == 1 ? " thread: " : " threads: ") << (long)(threads * operations / seconds) << " ops/s, " << (long)(reads / seconds) << " reads/s" << endl;
+	}
+}
+
+// rwmix <count> <read percent> [max threads] [mutex]: throughput of Search() reads mixed with Remove()/Insert() writes on a LockedGatorAVL
+// with 1, 2, 4, ... up to max threads (8 by default), or on the same tree behind one plain mutex
+void BenchReadWriteMix(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int readPercent = argc < 4 ? 95 : stoi(argv[3]);
+	unsigned int maxThreads = argc < 5 ? 8 : stoi(argv[4]);
+	if (argc > 5 && string(argv[5]) == "mutex") {
+		RunReadWriteMix<MutexGatorAVL>(count, readPercent, maxThreads);
+	}
+	else {
+		RunReadWriteMix<LockedGatorAVL>(count, readPercent, maxThreads);
+	}
+}
+
+void PrintMixStats(ConcurrentGatorAVL& avlTree) {	// Removed nodes are freed by epochs, so report how far behind that fell
+	avlTree.PrintReclaimStats();
+}
+
+void PrintMixStats(LockedGatorAVL&) {	// Removed nodes are freed at once
+}
+
+template <typename Tree>
+void RunConcurrentMix(int count, int searchPercent, unsigned int maxThreads) {
+	const int operations = 100000;	// Per thread
+	vector<string> idStrings = ShuffledIDs(2 * count);
+	vector<uint32_t> ids;
+	for (int i = 0; i < idStrings.size(); i++) {
+		ids.push_back(stoul(idStrings[i]));
+	}
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		Tree avlTree;
+		for (int i = 0; i < count; i++) {	// Half of the gatorIDs start in the tree
+			avlTree.Insert("registrar", ids[i]);
+		}
+		vector<thread> workers;
+		auto start = chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threads; t++) {
+			workers.push_back(thread([&avlTree, &ids, searchPercent, t] {
+				mt19937 random(t);
+				GatorAVL::GatorRecord record;
+				for (int i = 0; i < operations; i++) {
+					uint32_t gatorID = ids[random() % ids.size()];
+					int choice = random() % 100;
+					if (choice < searchPercent) {
+						avlTree.Search(gatorID, record);
+					}
+					else if (choice % 2 == 0) {		// The rest are split evenly between inserts and removes, so the tree keeps its size
+						avlTree.Insert("registrar", gatorID);
+					}
+					else {
+						avlTree.Remove(gatorID);
+					}
+				}
+			}));
+		}
+		for (unsigned int t = 0; t < threads; t++) {
+			workers[t].join();
+		}
+		cout << threads << (threads == 1 ? " thread: " : " threads: ") << (long)(threads * operations / Seconds(start)) << " ops/s" << endl;
+		PrintMixStats(avlTree);
+	}
+}
+
+// concurrent <count> <search percent> [max threads] [locked]: throughput of searches mixed with inserts and removes on a ConcurrentGatorAVL
+// with 1, 2, 4, ... up to max threads (64 by default), or on a LockedGatorAVL -- gatorIDs are drawn from 2 * count, half of them in the tree
+void BenchConcurrent(int argc, char** argv) {
+	int count = argc < 3 ? 1000000 : stoi(argv[2]);
+	int searchPercent = argc < 4 ? 90 : stoi(argv[3]);
+	unsigned int maxThreads = argc < 5 ? 64 : stoi(argv[4]);
+	if (argc > 5 && string(argv[5]) == "locked") {
+		RunConcurrentMix<LockedGatorAVL>(count, searchPercent, maxThreads);
+	}
+	else {
+		RunConcurrentMix<ConcurrentGatorAVL>(count, searchPercent, maxThreads);
+	}
+}
+
+int main(int argc, char** argv) {
+	string benchmark = argc < 2 ? "" : argv[1];
+	if (benchmark == "insert") {
+		BenchInsert(argc, argv);
+	}
+	else if (benchmark == "lookup") {
+		BenchLookup(argc, argv);
+	}
+	else if (benchmark == "retrace") {
+		BenchRetrace(argc, argv);
+	}
+	else if (benchmark == "allocs") {
+		BenchAllocations(argc, argv);
+	}
+	else if (benchmark == "mix") {
+		BenchMissMix(argc, argv);
+	}
+	else if (benchmark == "prefix") {
+		BenchPrefix(argc, argv);
+	}
+	else if (benchmark == "batch") {
+		BenchBatch(argc, argv);
+	}
+	else if (benchmark == "count") {
+		BenchCount(argc, argv);
+	}
+	else if (benchmark == "finger") {
+		BenchFinger(argc, argv);
+	}
+	else if (benchmark == "setops") {
+		BenchSetOperations(argc, argv);
+	}
+	else if (benchmark == "rwmix") {
+		BenchReadWriteMix(argc, argv);
+	}
+	else if (benchmark == "concurrent") {
+		BenchConcurrent(argc, argv);
+	}
+	else {
+		cout << "usage: GatorAVL_Bench insert <heap|pool> <count>" << endl;
+		cout << "       GatorAVL_Bench lookup <count> [compact]" << endl;
+		cout << "       GatorAVL_Bench retrace <count>" << endl;
+		cout << "       GatorAVL_Bench allocs <count> <distinct names>" << endl;
+		cout << "       GatorAVL_Bench mix <count> <miss percent>" << endl;
+		cout << "       GatorAVL_Bench prefix <count> <distinct names> [index]" << endl;
+		cout << "       GatorAVL_Bench batch <tree size> <batch size>" << endl;
+		cout << "       GatorAVL_Bench count <count> <range width>" << endl;
+		cout << "       GatorAVL_Bench finger <count> <sequential|clustered|random>" << endl;
+		cout << "       GatorAVL_Bench setops <count> [max threads]" << endl;
+		cout << "       GatorAVL_Bench rwmix <count> <read percent> [max threads] [mutex]" << endl;
+		cout << "       GatorAVL_Bench concurrent <count> <search percent> [max threads] [locked]" << endl;
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
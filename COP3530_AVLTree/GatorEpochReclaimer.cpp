@@ -0,0 +1,144 @@
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "GatorEpochReclaimer.h"
+
+// Every thread takes a process-wide slot index on first use and gives it back when it exits, so indexes stay below maxThreads
+mutex threadSlotLock;
+vector<bool> threadSlotUsed(GatorEpochReclaimer::maxThreads);
+
+struct ThreadSlot {
+	int index;
+
+	ThreadSlot() {
+		while (true) {
+			{
+				lock_guard<mutex> guard(threadSlotLock);
+				for (int i = 0; i < threadSlotUsed.size(); i++) {
+					if (!threadSlotUsed[i]) {
+						threadSlotUsed[i] = true;
+						index = i;
+						return;
+					}
+				}
+			}
+			this_thread::yield();
+		}
+	}
+
+	~ThreadSlot() {
+		lock_guard<mutex> guard(threadSlotLock);
+		threadSlotUsed[index] = false;
+	}
+};
+
+GatorEpochReclaimer::Slot::Slot() {
+	announced = 0;
+	depth = 0;
+}
+
+GatorEpochReclaimer::Guard::Guard(GatorEpochReclaimer& reclaimer) : reclaimer(reclaimer) {
+	reclaimer.Enter();
+}
+
+GatorEpochReclaimer::Guard::~Guard() {
+	reclaimer.Leave();
+}
+
+GatorEpochReclaimer::GatorEpochReclaimer(size_t batchSize) {
+	slots.reset(new Slot[maxThreads]);
+	epoch = 1;	// Announcements start at 1, since 0 means outside
+	this->batchSize = batchSize;
+	pending = 0;
+	maxPending = 0;
+	freed = 0;
+	latencySum = 0;
+	maxLatency = 0;
+}
+
+GatorEpochReclaimer::~GatorEpochReclaimer() {
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	for (int i = 0; i < maxThreads; i++) {
+		for (int j = 0; j < slots[i].retired.size(); j++) {
+			Free(slots[i].retired[j], now);
+		}
+	}
+}
+
+GatorEpochReclaimer::Slot& GatorEpochReclaimer::CurrentSlot() {
+	thread_local ThreadSlot threadSlot;
+	return slots[threadSlot.index];
+}
+
+void GatorEpochReclaimer::Enter() {
+	Slot& slot = CurrentSlot();
+	if (slot.depth++ == 0) {
+		slot.announced = epoch.load();	// Sequentially consistent, so a Reclaim() that misses this store cannot free anything the reader goes on to find
+	}
+}
+
+void GatorEpochReclaimer::Leave() {
+	Slot& slot = CurrentSlot();
+	if (--slot.depth == 0) {
+		slot.announced.store(0, memory_order_release);
+	}
+}
+
+void GatorEpochReclaimer::Retire(const void* object, void (*free)(const void*)) {
+	Slot& slot = CurrentSlot();
+	slot.retired.push_back({ object, free, epoch.load(), chrono::steady_clock::now() });
+	long count = ++pending;
+	long previousMax = maxPending;
+	while (count > previousMax && !maxPending.compare_exchange_weak(previousMax, count)) {}
+	if (slot.retired.size() % batchSize == 0) {
+		Reclaim();
+	}
+}
+
+void GatorEpochReclaimer::Reclaim() {
+	Slot& slot = CurrentSlot();
+	unsigned long oldest = ++epoch;		// Readers that enter from now on cannot reach anything retired so far
+	for (int i = 0; i < maxThreads; i++) {
+		unsigned long announced = slots[i].announced;
+		if (announced && announced < oldest) {
+			oldest = announced;
+		}
+	}
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	int kept = 0;
+	for (int i = 0; i < slot.retired.size(); i++) {		// Free what is older than every reader still inside, keeping the rest in order
+		if (slot.retired[i].epoch < oldest) {
+			Free(slot.retired[i], now);
+		}
+		else {
+			slot.retired[kept++] = slot.retired[i];
+		}
+	}
+	slot.retired.resize(kept);
+}
+
+void GatorEpochReclaimer::Free(Retired& retired, chrono::steady_clock::time_point now) {
+	retired.free(retired.object);
+	long latency = chrono::duration_cast<chrono::nanoseconds>(now - retired.retiredAt).count();
+	latencySum += latency;
+	long previousMax = maxLatency;
+	while (latency > previousMax && !maxLatency.compare_exchange_weak(previousMax, latency)) {}
+	pending--;
+	freed++;
+}
+
+GatorEpochReclaimer::EpochStats GatorEpochReclaimer::GetStats() {
+	EpochStats stats;
+	stats.pending = pending;
+	stats.maxPending = maxPending;
+	stats.freed = freed;
+	stats.averageLatency = stats.freed ? latencySum / 1000.0 / stats.freed : 0;
+	stats.maxLatency = maxLatency / 1000.0;
+	return stats;
+}
+
+void GatorEpochReclaimer::PrintStats() {
+	EpochStats stats = GetStats();
+	cout << "retired: " << stats.pending << " pending (" << stats.maxPending << " at most), " << stats.freed << " freed" << endl;
+	cout << "reclamation latency: " << stats.averageLatency << " us average, " << stats.maxLatency << " us at most" << endl;
+}
\ No newline at end of file
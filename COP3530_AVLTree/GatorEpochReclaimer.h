@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// Epoch-based reclamation for structures whose readers take no locks: objects unlinked by a writer are retired instead of deleted,
+// and each thread frees its retired objects in batches once every reader that could still see them has left its epoch
+// Readers only write their own slot (no locks, no reference counts) -- Enter() announces the current epoch and Leave() clears it
+class GatorEpochReclaimer {
+	struct Retired {
+		const void* object;
+		void (*free)(const void*);
+		unsigned long epoch;	// The global epoch when the object was retired -- it is freed once no reader announces this epoch or an older one
+		chrono::steady_clock::time_point retiredAt;
+	};
+
+	struct alignas(64) Slot {	// One per thread (a cache line each, so readers do not slow each other down)
+		atomic<unsigned long> announced;	// 0 while the thread is outside the epoch
+		int depth;		// Nested Enter() calls -- only the outermost one announces
+		vector<Retired> retired;	// Only touched by the thread that owns the slot
+		Slot();
+	};
+
+public:
+	struct EpochStats {
+		long pending;	// Retired objects not freed yet (the total length of the retire lists)
+		long maxPending;
+		long freed;
+		double averageLatency;	// Microseconds from Retire() until the object was freed
+		double maxLatency;
+	};
+
+	// Keeps a thread inside the epoch for its lifetime
+	class Guard {
+	private:
+		GatorEpochReclaimer& reclaimer;
+
+	public:
+		Guard(GatorEpochReclaimer& reclaimer);
+		~Guard();
+		Guard(const Guard&) = delete;
+		Guard& operator=(const Guard&) = delete;
+	};
+
+	static const int maxThreads = 256;	// Threads alive at once -- a thread past the limit waits in its first Enter() or Retire() for one to exit
+
+private:
+	unique_ptr<Slot[]> slots;
+	atomic<unsigned long> epoch;
+	// A thread tries to free its retire list whenever its length reaches a multiple of this -- objects it retired in its current epoch
+	// are kept until the next batch, so the list holds up to about two batches while the thread keeps working
+	size_t batchSize;
+	atomic<long> pending;
+	atomic<long> maxPending;
+	atomic<long> freed;
+	atomic<long> latencySum;	// Nanoseconds
+	atomic<long> maxLatency;
+
+	Slot& CurrentSlot();
+	void Free(Retired& retired, chrono::steady_clock::time_point now);
+
+public:
+	GatorEpochReclaimer(size_t batchSize = 256);
+	~GatorEpochReclaimer();		// Frees everything still retired -- no thread may be inside the epoch by then
+	GatorEpochReclaimer(const GatorEpochReclaimer&) = delete;
+	GatorEpochReclaimer& operator=(const GatorEpochReclaimer&) = delete;
+
+	void Enter();
+	void Leave();
+	template <typename T>
+	void Retire(T* object) {	// Hand over an object that has been unlinked, so no reader entering from now on can reach it
+		Retire(object, [](const void* object) { delete static_cast<const T*>(object); });
+	}
+	void Retire(const void* object, void (*free)(const void*));
+	void Reclaim();		// Advance the epoch and free what the calling thread retired that no reader can still see
+	EpochStats GetStats();
+	void PrintStats();
+};
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "GatorNameTable.h"
+
+unsigned long GatorNameTable::StringBytes(const string& name) {
+	const char* data = name.data();
+	const char* object = reinterpret_cast<const char*>(&name);
+	if (data >= object && data < object + sizeof(string)) {	// Short names are stored inside the string object itself
+		return sizeof(string);
+	}
+	return sizeof(string) + name.capacity() + 1;
+}
+
+GatorNameTable::GatorNameTable() {
+	for (int i = 0; i < chunkCount; i++) {
+		chunks[i] = nullptr;
+	}
+	capacity = 0;
+	totalReferences = 0;
+	bytesSaved = 0;
+}
+
+GatorNameTable::~GatorNameTable() {
+	for (int i = 0; i < chunkCount; i++) {
+		delete[] chunks[i];
+	}
+}
+
+GatorNameTable::NameEntry& GatorNameTable::Entry(uint32_t index) {
+	uint64_t position = index / firstChunkSize + 1;		// Chunk k starts at firstChunkSize * (2^k - 1), so k is the top bit of this
+	int chunk = 0;
+	while (position > 1) {
+		position >>= 1;
+		chunk++;
+	}
+	return chunks[chunk][index - firstChunkSize * ((1ull << chunk) - 1)];
+}
+
+bool GatorNameTable::AddReference(const string& name, uint32_t& index) {
+	auto found = lookup.find(name);
+	if (found == lookup.end()) {
+		return false;
+	}
+	Retain(found->second);
+	index = found->second;
+	return true;
+}
+
+uint32_t GatorNameTable::Store(string&& name) {
+	uint32_t index;
+	if (!freeIndices.empty()) {
+		index = freeIndices.back();
+		freeIndices.pop_back();
+	}
+	else {
+		index = capacity;
+		uint64_t position = index / firstChunkSize + 1;
+		if ((position & (position - 1)) == 0 && index % firstChunkSize == 0) {	// First entry of a new chunk
+			int chunk = 0;
+			while (position > 1) {
+				position >>= 1;
+				chunk++;
+			}
+			chunks[chunk] = new NameEntry[(size_t)firstChunkSize << chunk];
+		}
+		capacity++;
+	}
+	auto inserted = lookup.emplace(move(name), index).first;
+	NameEntry& entry = Entry(index);
+	entry.name = &inserted->first;
+	entry.references = 1;
+	totalReferences++;
+	return index;
+}
+
+uint32_t GatorNameTable::Intern(const string& name) {
+	uint32_t index;
+	if (AddReference(name, index)) {
+		return index;
+	}
+	return Store(string(name));
+}
+
+uint32_t GatorNameTable::Intern(string&& name) {
+	uint32_t index;
+	if (AddReference(name, index)) {
+		return index;
+	}
+	return Store(move(name));
+}
+
+bool GatorNameTable::Find(const string& name, uint32_t& index) {
+	auto found = lookup.find(name);
+	if (found == lookup.end()) {
+		return false;
+	}
+	index = found->second;
+	return true;
+}
+
+void GatorNameTable::Retain(uint32_t index) {
+	NameEntry& entry = Entry(index);
+	entry.references++;
+	totalReferences++;
+	bytesSaved += StringBytes(*entry.name);
+}
+
+void GatorNameTable::Release(uint32_t index) {
+	NameEntry& entry = Entry(index);
+	entry.references--;
+	totalReferences--;
+	if (entry.references > 0) {
+		bytesSaved -= StringBytes(*entry.name);
+		return;
+	}
+	lookup.erase(*entry.name);
+	entry.name = nullptr;
+	freeIndices.push_back(index);
+}
+
+void GatorNameTable::FindPrefix(const string& prefix, vector<uint32_t>& indices) {
+	// Names sharing a prefix are adjacent in sorted order, starting at the first name not less than the prefix
+	for (auto it = lookup.lower_bound(prefix); it != lookup.end() && it->first.compare(0, prefix.length(), prefix) == 0; it++) {
+		indices.push_back(it->second);
+	}
+}
+
+const string& GatorNameTable::Get(uint32_t index) {
+	return *Entry(index).name;
+}
+
+int GatorNameTable::GetCount() {
+	return capacity - freeIndices.size();
+}
+
+int GatorNameTable::GetCapacity() {
+	return capacity;
+}
+
+unsigned long GatorNameTable::GetReferenceCount() {
+	return totalReferences;
+}
+
+double GatorNameTable::GetDedupRatio() {
+	if (GetCount() == 0) {
+		return 1.0;
+	}
+	return (double)totalReferences / GetCount();
+}
+
+unsigned long GatorNameTable::GetBytesSaved() {
+	return bytesSaved;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <map>
+
+using namespace std;
+
+// Cold storage for the names of a GatorAVL -- nodes only keep a 32-bit index into this table,
+// so the fields used while searching by gatorID stay packed together
+// Names are interned: every node with the same name shares one index and one copy of the string
+// Entries never move once stored, so another thread can keep calling Get() for names it already holds while new names are added
+class GatorNameTable {
+	struct NameEntry {
+		const string* name;		// Points at the key in the lookup map (map nodes never move)
+		uint32_t references;	// Number of nodes using this name -- 0 while the index sits on the free list
+	};
+
+private:
+	map<string, uint32_t> lookup;		// Name to index, kept in sorted order so names can be searched by prefix
+	// Entries live in chunks that double in size (chunk k holds firstChunkSize << k of them) and are never reallocated
+	static const uint32_t firstChunkSize = 1024;
+	static const int chunkCount = 23;	// Enough chunks for every 32-bit index
+	NameEntry* chunks[chunkCount];
+	uint32_t capacity;	// Entries handed out so far
+	vector<uint32_t> freeIndices;	// Indices of released names that can be handed out again
+	unsigned long totalReferences;
+	unsigned long bytesSaved;	// Bytes that separate copies of every duplicate name would have used
+
+	static unsigned long StringBytes(const string& name);	// Memory used by one copy of a string, including its heap buffer
+	bool AddReference(const string& name, uint32_t& index);		// Count one more use of a name that is already stored
+	uint32_t Store(string&& name);	// Take ownership of a name that is not stored yet
+	NameEntry& Entry(uint32_t index);
+
+public:
+	GatorNameTable();
+	~GatorNameTable();
+	GatorNameTable(const GatorNameTable&) = delete;
+	GatorNameTable& operator=(const GatorNameTable&) = delete;
+	// Return the index of a name, storing it if it is not already in the table
+	// The name is only copied (or moved, for an rvalue) when it is new to the table
+	uint32_t Intern(const string& name);
+	uint32_t Intern(string&& name);
+	bool Find(const string& name, uint32_t& index);		// Look up the index of a name without storing it
+	void Retain(uint32_t index);	// Count one more use of a stored name by its index (for a copy of a node)
+	void Release(uint32_t index);	// Drop one reference to a name, removing it once no nodes use it
+	void FindPrefix(const string& prefix, vector<uint32_t>& indices);	// Collect the index of every stored name that starts with prefix
+	const string& Get(uint32_t index);
+	int GetCount();		// Number of distinct names currently stored
+	int GetCapacity();	// One past the largest index handed out so far
+	unsigned long GetReferenceCount();	// Number of nodes referring to a name
+	double GetDedupRatio();		// References per distinct name
+	unsigned long GetBytesSaved();
+};
\ No newline at end of file
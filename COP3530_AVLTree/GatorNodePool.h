@@ -0,0 +1,101 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Slab allocator that hands out fixed-size slots for one node type from contiguous chunks
+// Freed slots are kept on an intrusive free list and reused before a new chunk is requested
+template <typename T>
+class GatorNodePool {
+	union Slot {
+		Slot* next;		// Only valid while the slot sits on the free list
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+private:
+	vector<Slot*> chunks;
+	Slot* freeList;
+	size_t chunkSize;	// Number of slots in each chunk
+	size_t chunkCapacity;	// Number of slots in the most recent chunk (larger than chunkSize after Reserve())
+	size_t chunkUsed;	// Number of slots handed out from the most recent chunk
+	size_t inUse;
+
+	void NewChunk(size_t capacity) {
+		chunks.push_back(static_cast<Slot*>(::operator new(sizeof(Slot) * capacity)));
+		chunkCapacity = capacity;
+		chunkUsed = 0;
+	}
+
+public:
+	GatorNodePool(size_t chunkSize = 1024) {
+		this->chunkSize = chunkSize;
+		freeList = nullptr;
+		chunkCapacity = 0;
+		chunkUsed = 0;	// Forces a chunk to be allocated on the first request
+		inUse = 0;
+	}
+
+	~GatorNodePool() {	// Releases every chunk at once -- objects still alive are not destroyed
+		for (int i = 0; i < chunks.size(); i++) {
+			::operator delete(chunks[i]);
+		}
+	}
+
+	GatorNodePool(const GatorNodePool&) = delete;
+	GatorNodePool& operator=(const GatorNodePool&) = delete;
+
+	template <typename... Args>
+	T* Allocate(Args&&... args) {
+		Slot* slot;
+		if (freeList) {
+			slot = freeList;
+			freeList = freeList->next;
+		}
+		else {
+			if (chunkUsed == chunkCapacity) {
+				NewChunk(chunkSize);
+			}
+			slot = chunks.back() + chunkUsed;
+			chunkUsed++;
+		}
+		inUse++;
+		return new (slot->storage) T(forward<Args>(args)...);
+	}
+
+	void Free(T* object) {
+		object->~T();
+		Slot* slot = reinterpret_cast<Slot*>(object);
+		slot->next = freeList;
+		freeList = slot;
+		inUse--;
+	}
+
+	// Make sure a chunk with room for count more slots is ready -- what is left of the current chunk goes on the free list so it is not lost,
+	// and since the free list is used first, the next count allocations are only adjacent in a pool that has nothing on it (as in a new pool)
+	void Reserve(size_t count) {
+		if (chunkCapacity - chunkUsed < count) {
+			for (size_t i = chunkUsed; i < chunkCapacity; i++) {
+				Slot* slot = chunks.back() + i;
+				slot->next = freeList;
+				freeList = slot;
+			}
+			NewChunk(max(count, chunkSize));
+		}
+	}
+
+	size_t GetChunkSize() {
+		return chunkSize;
+	}
+
+	size_t GetChunkCount() {
+		return chunks.size();
+	}
+
+	size_t GetInUseCount() {
+		return inUse;
+	}
+};
\ No newline at end of file
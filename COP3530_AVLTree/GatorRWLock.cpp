@@ -0,0 +1,40 @@
+#include "GatorRWLock.h"
+
+GatorRWLock::GatorRWLock() {
+	readers = 0;
+	waitingWriters = 0;
+	writing = false;
+}
+
+void GatorRWLock::lock_shared() {
+	unique_lock<mutex> guard(stateLock);
+	readersGo.wait(guard, [this] { return !writing && waitingWriters == 0; });
+	readers++;
+}
+
+void GatorRWLock::unlock_shared() {
+	lock_guard<mutex> guard(stateLock);
+	readers--;
+	if (readers == 0 && waitingWriters > 0) {
+		writersGo.notify_one();
+	}
+}
+
+void GatorRWLock::lock() {
+	unique_lock<mutex> guard(stateLock);
+	waitingWriters++;
+	writersGo.wait(guard, [this] { return !writing && readers == 0; });
+	waitingWriters--;
+	writing = true;
+}
+
+void GatorRWLock::unlock() {
+	lock_guard<mutex> guard(stateLock);
+	writing = false;
+	if (waitingWriters > 0) {	// Writers go first -- readers are only let in once none are left waiting
+		writersGo.notify_one();
+	}
+	else {
+		readersGo.notify_all();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+
+// Reader-writer lock that prefers writers: once a writer is waiting, new readers wait behind it, so a steady stream of readers cannot starve writers
+// std::shared_mutex leaves the policy to the platform (glibc favours readers), which is why this is not just a shared_mutex
+// The member names follow the standard library so that unique_lock and shared_lock work with it
+class GatorRWLock {
+private:
+	mutex stateLock;	// Guards the counts below
+	condition_variable readersGo;	// Signalled when the last writer leaves
+	condition_variable writersGo;	// Signalled when the lock becomes free for the next writer
+	int readers;	// Readers holding the lock
+	int waitingWriters;
+	bool writing;
+
+public:
+	GatorRWLock();
+	GatorRWLock(const GatorRWLock&) = delete;
+	GatorRWLock& operator=(const GatorRWLock&) = delete;
+
+	void lock_shared();
+	void unlock_shared();
+	void lock();
+	void unlock();
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "GatorThreadPool.h"
+
+GatorThreadPool::GatorThreadPool(unsigned int threads) {
+	stopping = false;
+	for (unsigned int i = 1; i < threads; i++) {
+		workers.push_back(thread(&GatorThreadPool::WorkerLoop, this));
+	}
+}
+
+GatorThreadPool::~GatorThreadPool() {
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	available.notify_all();
+	for (int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+}
+
+void GatorThreadPool::WorkerLoop() {
+	while (true) {
+		function<void()> task;
+		{
+			unique_lock<mutex> guard(lock);
+			available.wait(guard, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) {	// Only reached once the pool is stopping
+				return;
+			}
+			task = move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+bool GatorThreadPool::RunPending() {
+	function<void()> task;
+	{
+		lock_guard<mutex> guard(lock);
+		if (tasks.empty()) {
+			return false;
+		}
+		task = move(tasks.back());	// The newest task is the smallest piece of the recursion, so the caller's wait stays short
+		tasks.pop_back();
+	}
+	task();
+	return true;
+}
+
+void GatorThreadPool::Submit(function<void()> task, atomic<int>& pending) {
+	pending++;
+	if (workers.empty()) {	// A pool of one thread runs everything in place
+		task();
+		pending--;
+		return;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		tasks.push_back([task, &pending] {
+			task();
+			pending--;
+		});
+	}
+	available.notify_one();
+}
+
+void GatorThreadPool::Wait(atomic<int>& pending) {
+	while (pending > 0) {
+		if (!RunPending()) {
+			this_thread::yield();
+		}
+	}
+}
+
+unsigned int GatorThreadPool::GetThreadCount() {
+	return workers.size() + 1;
+}
\ No newline at end of file
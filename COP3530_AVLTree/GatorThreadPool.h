@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Fixed set of worker threads for fork-join recursion -- a task forks its second half with Submit() and calls Wait() after doing its first half
+// A waiting thread runs queued tasks instead of blocking, so nested forks cannot use up the workers and deadlock
+class GatorThreadPool {
+private:
+	vector<thread> workers;
+	deque<function<void()>> tasks;
+	mutex lock;		// Guards tasks and stopping
+	condition_variable available;	// Signalled when a task is queued or the pool is stopping
+	bool stopping;
+
+	void WorkerLoop();
+	bool RunPending();	// Run one queued task on the calling thread -- returns false if the queue was empty
+
+public:
+	GatorThreadPool(unsigned int threads);	// Starts threads - 1 workers, since the thread that calls Wait() does work too
+	~GatorThreadPool();
+	GatorThreadPool(const GatorThreadPool&) = delete;
+	GatorThreadPool& operator=(const GatorThreadPool&) = delete;
+
+	void Submit(function<void()> task, atomic<int>& pending);	// Queue a task, counting it in pending until it finishes
+	void Wait(atomic<int>& pending);	// Help with queued tasks until pending drops to zero
+	unsigned int GetThreadCount();		// Workers plus the calling thread
+};
\ No newline at end of file
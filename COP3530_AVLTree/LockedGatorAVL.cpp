@@ -0,0 +1,176 @@
+#include "LockedGatorAVL.h"
+
+LockedGatorAVL::LockedGatorAVL(unsigned int poolChunkSize) : tree(poolChunkSize) {
+}
+
+// Updates:
+GatorAVL::GatorStatus LockedGatorAVL::Insert(const string& name, const string& gatorID) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.Insert(name, gatorID);
+}
+
+GatorAVL::GatorStatus LockedGatorAVL::Remove(const string& gatorID) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.Remove(gatorID);
+}
+
+GatorAVL::GatorStatus LockedGatorAVL::Insert(const string& name, uint32_t gatorID) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.Insert(name, gatorID);
+}
+
+GatorAVL::GatorStatus LockedGatorAVL::Remove(uint32_t gatorID) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.Remove(gatorID);
+}
+
+GatorAVL::GatorStatus LockedGatorAVL::RemoveInorder(int index) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.RemoveInorder(index);
+}
+
+int LockedGatorAVL::RemoveRange(uint32_t low, uint32_t high) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.RemoveRange(low, high);
+}
+
+GatorAVL::GatorStatus LockedGatorAVL::RemoveRange(const string& low, const string& high) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.RemoveRange(low, high);
+}
+
+vector<GatorAVL::GatorStatus> LockedGatorAVL::InsertBatch(vector<pair<string, uint32_t>> records) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.InsertBatch(move(records));
+}
+
+vector<GatorAVL::GatorStatus> LockedGatorAVL::BulkLoad(vector<pair<string, string>> records) {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.BulkLoad(move(records));
+}
+
+void LockedGatorAVL::SetNameIndex(bool enabled) {
+	unique_lock<GatorRWLock> guard(lock);
+	tree.SetNameIndex(enabled);
+}
+
+void LockedGatorAVL::Compact() {
+	unique_lock<GatorRWLock> guard(lock);
+	tree.Compact();
+}
+
+shared_ptr<const GatorAVL::Version> LockedGatorAVL::Snapshot() {
+	unique_lock<GatorRWLock> guard(lock);
+	return tree.Snapshot();
+}
+
+// Queries:
+void LockedGatorAVL::Search(string term) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.Search(term);
+}
+
+void LockedGatorAVL::SearchPrefix(const string& prefix) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.SearchPrefix(prefix);
+}
+
+bool LockedGatorAVL::Search(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.Search(gatorID, record);
+}
+
+vector<uint32_t> LockedGatorAVL::FindPrefix(const string& prefix) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.FindPrefix(prefix);
+}
+
+void LockedGatorAVL::SearchRange(const string& low, const string& high) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.SearchRange(low, high);
+}
+
+void LockedGatorAVL::Inorder() {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.Inorder();
+}
+
+void LockedGatorAVL::Preorder() {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.Preorder();
+}
+
+void LockedGatorAVL::Postorder() {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.Postorder();
+}
+
+void LockedGatorAVL::PrintLevelCount() {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.PrintLevelCount();
+}
+
+void LockedGatorAVL::PrintNameStats() {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.PrintNameStats();
+}
+
+void LockedGatorAVL::PrintRank(string gatorID) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.PrintRank(gatorID);
+}
+
+void LockedGatorAVL::PrintSelect(int index) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.PrintSelect(index);
+}
+
+bool LockedGatorAVL::SelectByRank(int index, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.SelectByRank(index, record);
+}
+
+int LockedGatorAVL::RankOf(uint32_t gatorID) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.RankOf(gatorID);
+}
+
+bool LockedGatorAVL::LowerBound(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.LowerBound(gatorID, record);
+}
+
+bool LockedGatorAVL::UpperBound(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.UpperBound(gatorID, record);
+}
+
+bool LockedGatorAVL::Predecessor(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.Predecessor(gatorID, record);
+}
+
+bool LockedGatorAVL::Successor(uint32_t gatorID, GatorAVL::GatorRecord& record) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.Successor(gatorID, record);
+}
+
+int LockedGatorAVL::CountRange(uint32_t low, uint32_t high) {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.CountRange(low, high);
+}
+
+void LockedGatorAVL::PrintCountRange(const string& low, const string& high) {
+	shared_lock<GatorRWLock> guard(lock);
+	tree.PrintCountRange(low, high);
+}
+
+int LockedGatorAVL::GetSize() {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.GetSize();
+}
+
+int LockedGatorAVL::GetLevelCount() {
+	shared_lock<GatorRWLock> guard(lock);
+	return tree.GetLevelCount();
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include <shared_mutex>
+#include "GatorAVL.h"
+#include "GatorRWLock.h"
+
+using namespace std;
+
+// Thread-safe facade over a GatorAVL: queries share a reader-writer lock, so any number of them run at once, while updates hold it alone
+// The lock prefers writers, so updates are not starved by a steady stream of queries
+// Queries that print can interleave their lines with other threads' output -- use the functions that return results to avoid that
+// Finger operations are left out, since even a finger search moves the finger and would need the lock to itself
+class LockedGatorAVL {
+private:
+	GatorAVL tree;
+	GatorRWLock lock;
+
+public:
+	LockedGatorAVL(unsigned int poolChunkSize = 1024);
+	LockedGatorAVL(const LockedGatorAVL&) = delete;
+	LockedGatorAVL& operator=(const LockedGatorAVL&) = delete;
+
+	// Updates (exclusive):
+	GatorAVL::GatorStatus Insert(const string& name, const string& gatorID);
+	GatorAVL::GatorStatus Remove(const string& gatorID);
+	GatorAVL::GatorStatus Insert(const string& name, uint32_t gatorID);		// Does not print, like the other functions taking a numeric gatorID
+	GatorAVL::GatorStatus Remove(uint32_t gatorID);
+	GatorAVL::GatorStatus RemoveInorder(int index);
+	int RemoveRange(uint32_t low, uint32_t high);
+	GatorAVL::GatorStatus RemoveRange(const string& low, const string& high);
+	vector<GatorAVL::GatorStatus> InsertBatch(vector<pair<string, uint32_t>> records);
+	vector<GatorAVL::GatorStatus> BulkLoad(vector<pair<string, string>> records);
+	void SetNameIndex(bool enabled);
+	void Compact();
+	shared_ptr<const GatorAVL::Version> Snapshot();		// Taking a version changes reference counts, so it is an update too
+
+	// Queries (shared):
+	void Search(string term);
+	void SearchPrefix(const string& prefix);
+	bool Search(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	vector<uint32_t> FindPrefix(const string& prefix);
+	template <typename Callback>
+	void ForEachInRange(uint32_t low, uint32_t high, Callback callback) {	// The callback runs under the shared lock, so it must not update the tree
+		shared_lock<GatorRWLock> guard(lock);
+		tree.ForEachInRange(low, high, callback);
+	}
+	void SearchRange(const string& low, const string& high);
+	void Inorder();
+	void Preorder();
+	void Postorder();
+	void PrintLevelCount();
+	void PrintNameStats();
+	void PrintRank(string gatorID);
+	void PrintSelect(int index);
+	bool SelectByRank(int index, GatorAVL::GatorRecord& record);
+	int RankOf(uint32_t gatorID);
+	bool LowerBound(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	bool UpperBound(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	bool Predecessor(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	bool Successor(uint32_t gatorID, GatorAVL::GatorRecord& record);
+	int CountRange(uint32_t low, uint32_t high);
+	void PrintCountRange(const string& low, const string& high);
+	int GetSize();
+	int GetLevelCount();
+};
\ No newline at end of file